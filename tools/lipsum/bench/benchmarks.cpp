@@ -0,0 +1,514 @@
+#include "harness.hpp"
+#include "alias.hpp"
+#include "dictionary.hpp"
+#include "grammar.hpp"
+#include "lexicon.hpp"
+#include "lipsum.hpp"
+#include "markov.hpp"
+#include "output.hpp"
+#include "parallel.hpp"
+#include "random.hpp"
+#include "scan.hpp"
+#include "sink.hpp"
+#include "source.hpp"
+#include "stats.hpp"
+#include "text.hpp"
+#include "types.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+/*
+ * Microbenchmarks for the generation hot path, the text helpers and the whole binary.
+ * Items are sentences unless the registration says otherwise.
+ */
+
+using namespace GrammarNS;
+
+namespace {
+
+const int64_t KB = 1024;
+const int64_t MB = 1024 * KB;
+const int64_t GB = 1024 * MB;
+
+/* Average output sizes, used to turn a byte target into -w / -p counts */
+const double BYTES_PER_WORD = 7.2;
+const double BYTES_PER_PARAGRAPH = 342.0;
+
+/* Stream buffer that throws everything away, so writer benchmarks measure no I/O */
+class NullBuffer : public std::streambuf {
+protected:
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+    int_type overflow(int_type c) override { return traits_type::not_eof(c); }
+};
+
+/* About @p bytes of generated text, split into paragraphs like lipsum's output */
+const std::string& sample_text(size_t bytes) {
+    static std::string text;
+    if (text.size() < bytes) {
+        Random rng(Random::Engine::MT19937, 42);
+        Grammar grammar(rng);
+        Lexicon lexicon(rng, get_test_word_table());
+        std::vector<Token> tokens;
+        text.clear();
+        int sentence = 0;
+        TextStats stats;
+        while (text.size() < bytes) {
+            grammar.generate_sentence_skeleton(tokens);
+            lexicon.fillTokens(tokens, text, stats);
+            text += (++sentence % 6 == 0) ? "\n\n" : " ";
+        }
+    }
+    return text;
+}
+
+const int64_t CACHED = 1 << 8;
+
+/* arg is the Mode, plus CACHED to sample from the SkeletonCache */
+void BM_Skeleton(Bench::State& state) {
+    Random rng(Random::Engine::MT19937, 1);
+    Grammar grammar(rng, static_cast<Mode>(state.arg() & 0xFF), (state.arg() & CACHED) != 0);
+    std::vector<Token> tokens;
+    uint64_t token_count = 0;
+    while (state.keep_running()) {
+        grammar.generate_sentence_skeleton(tokens);
+        token_count += tokens.size();
+    }
+    Bench::do_not_optimize(token_count);
+    state.set_items_processed(state.iterations());
+}
+
+void BM_FillTokens(Bench::State& state) {
+    Random rng(Random::Engine::MT19937, 1);
+    Grammar grammar(rng);
+    Lexicon lexicon(rng, get_test_word_table());
+    std::vector<std::vector<Token>> skeletons(1024);
+    for (auto& skeleton : skeletons) {
+        grammar.generate_sentence_skeleton(skeleton);
+    }
+
+    TextStats stats;
+    std::string sentence;
+    size_t i = 0;
+    while (state.keep_running()) {
+        sentence.clear();
+        lexicon.fillTokens(skeletons[i++ & 1023], sentence, stats);
+        Bench::do_not_optimize(sentence);
+    }
+    state.set_bytes_processed(stats.characters);
+    state.set_items_processed(state.iterations());
+}
+
+/* A whole sentence (skeleton and words) per iteration; arg selects the Random engine */
+void BM_Sentence(Bench::State& state) {
+    Random rng(static_cast<Random::Engine>(state.arg()), 1);
+    Grammar grammar(rng);
+    Lexicon lexicon(rng, get_test_word_table());
+    std::vector<Token> tokens;
+    TextStats stats;
+    std::string sentence;
+    while (state.keep_running()) {
+        grammar.generate_sentence_skeleton(tokens);
+        sentence.clear();
+        lexicon.fillTokens(tokens, sentence, stats);
+        Bench::do_not_optimize(sentence);
+    }
+    state.set_bytes_processed(stats.characters);
+    state.set_items_processed(state.iterations());
+}
+
+/* Sentences through TextSource::generate_sentences(), arg at a time */
+void BM_SentenceBatch(Bench::State& state) {
+    Random rng(Random::Engine::MT19937, 1);
+    Grammar grammar(rng);
+    Lexicon lexicon(rng, get_test_word_table());
+    SequentialSource source(grammar, lexicon, rng);
+    TextStats stats;
+    std::string text;
+    while (state.keep_running()) {
+        text.clear();
+        source.generate_sentences(static_cast<size_t>(state.arg()), text, stats);
+        Bench::do_not_optimize(text);
+    }
+    state.set_bytes_processed(stats.characters);
+    state.set_items_processed(stats.sentences);
+}
+
+/* One library call per iteration, reusing the caller's buffer; arg is the paragraph count */
+void BM_GeneratorParagraphs(Bench::State& state) {
+    Lipsum::Generator generator;
+    std::string text;
+    uint64_t bytes = 0;
+    unsigned int seed = 1;
+    while (state.keep_running()) {
+        text.clear();
+        generator.generate(Lipsum::Unit::PARAGRAPHS, static_cast<size_t>(state.arg()), seed++, text);
+        bytes += text.size();
+        Bench::do_not_optimize(text);
+    }
+    state.set_bytes_processed(bytes);
+    state.set_items_processed(state.iterations());
+}
+
+const int STEADY_STATE_WARMUP_PARAGRAPHS = 2000;
+
+/**
+ * Paragraphs from a source into a writer, once every reused buffer has grown to its
+ * working size. Exits with an error if that steady state makes any heap allocation (only
+ * detectable with STATS=1, which links the counting hook). arg is the thread count, or 0
+ * for a SequentialSource.
+ **/
+void BM_SteadyState(Bench::State& state) {
+    Random rng(Random::Engine::MT19937, 1);
+    Grammar grammar(rng);
+    Lexicon lexicon(rng, get_test_word_table());
+    std::unique_ptr<TextSource> source;
+    if (state.arg() == 0) {
+        source = std::make_unique<SequentialSource>(grammar, lexicon, rng);
+    } else {
+        source = std::make_unique<ParallelSource>(get_test_word_table(), nullptr, Mode::NORMAL, false,
+                                                  Random::Engine::MT19937, 1,
+                                                  static_cast<unsigned int>(state.arg()));
+    }
+    NullBuffer null_buffer;
+    std::ostream null_stream(&null_buffer);
+    OutputWriter writer(null_stream, true);
+    TextStats stats;
+    for (int i = 0; i < STEADY_STATE_WARMUP_PARAGRAPHS; i++) {
+        writer.write(source->next_paragraph(stats));
+        writer.write("\n\n");
+    }
+
+    TextStats measured;
+    uint64_t allocations = Stats::allocations();
+    while (state.keep_running()) {
+        writer.write(source->next_paragraph(measured));
+        writer.write("\n\n");
+    }
+    allocations = Stats::allocations() - allocations;
+    if (allocations > 0) {
+        std::fprintf(stderr, "Error: %llu heap allocations in steady-state generation\n",
+                     static_cast<unsigned long long>(allocations));
+        std::exit(EXIT_FAILURE);
+    }
+    state.set_bytes_processed(measured.characters);
+    state.set_items_processed(state.iterations());
+}
+
+/* A model of @p order trained on 1MB of sample text, loaded through a temporary file */
+const MarkovModel& sample_model(unsigned int order) {
+    static std::unique_ptr<MarkovModel> models[MARKOV_MAX_ORDER + 1];
+    if (!models[order]) {
+        char path[] = "/tmp/lipsum_bench_XXXXXX";
+        int fd = mkstemp(path);
+        std::string image = build_markov_model(sample_text(MB), order);
+        if (fd < 0 || write(fd, image.data(), image.size()) != static_cast<ssize_t>(image.size())) {
+            std::fprintf(stderr, "Error: cannot write a model to %s\n", path);
+            std::exit(EXIT_FAILURE);
+        }
+        close(fd);
+        models[order] = std::make_unique<MarkovModel>(path);
+        unlink(path);
+    }
+    return *models[order];
+}
+
+/* Training on 1MB of sample text, file format included */
+void BM_MarkovTrain(Bench::State& state) {
+    const std::string& text = sample_text(MB);
+    while (state.keep_running()) {
+        std::string image = build_markov_model(text, static_cast<unsigned int>(state.arg()));
+        Bench::do_not_optimize(image);
+    }
+    state.set_bytes_processed(state.iterations() * text.size());
+}
+
+/* A whole sentence from a model per iteration, to compare with sentence/mt19937; arg is the order */
+void BM_MarkovSentence(Bench::State& state) {
+    const MarkovModel& model = sample_model(static_cast<unsigned int>(state.arg()));
+    Random rng(Random::Engine::MT19937, 1);
+    TextStats stats;
+    std::string sentence;
+    while (state.keep_running()) {
+        sentence.clear();
+        model.append_sentence(rng, sentence, stats);
+        Bench::do_not_optimize(sentence);
+    }
+    state.set_bytes_processed(stats.characters);
+    state.set_items_processed(state.iterations());
+}
+
+/* Raw bounded draws, the core of word selection */
+void BM_RandomBelow(Bench::State& state) {
+    Random rng(static_cast<Random::Engine>(state.arg()), 1);
+    size_t sum = 0;
+    while (state.keep_running()) {
+        sum += rng.below(1000);
+    }
+    Bench::do_not_optimize(sum);
+    state.set_items_processed(state.iterations());
+}
+
+const int64_t WEIGHTED = 1 << 16;
+
+/* arg packs the POS in the second byte and the gender in the low byte, plus WEIGHTED */
+void BM_SelectWord(Bench::State& state) {
+    Random rng(Random::Engine::MT19937, 1);
+    WeightedIndex weighted(get_test_word_table());
+    Lexicon lexicon(rng, get_test_word_table(), (state.arg() & WEIGHTED) ? &weighted : nullptr);
+    POS pos = static_cast<POS>((state.arg() >> 8) & 0xff);
+    char gender = static_cast<char>(state.arg() & 0xff);
+    size_t length = 0;
+    while (state.keep_running()) {
+        length += lexicon.select_word(pos, gender).size();
+    }
+    Bench::do_not_optimize(length);
+    state.set_items_processed(state.iterations());
+}
+
+/* Alias table construction for arg Zipf-weighted words */
+void BM_AliasBuild(Bench::State& state) {
+    std::vector<float> weights(static_cast<size_t>(state.arg()));
+    for (size_t i = 0; i < weights.size(); i++) {
+        weights[i] = 1.0f / static_cast<float>(i + 1);
+    }
+    while (state.keep_running()) {
+        AliasTable table(weights.data(), weights.size());
+        Bench::do_not_optimize(table);
+    }
+    state.set_items_processed(state.iterations() * weights.size());
+}
+
+/* Draws from a table of arg words, to show the cost does not grow with the vocabulary */
+void BM_AliasSample(Bench::State& state) {
+    std::vector<float> weights(static_cast<size_t>(state.arg()));
+    for (size_t i = 0; i < weights.size(); i++) {
+        weights[i] = 1.0f / static_cast<float>(i + 1);
+    }
+    AliasTable table(weights.data(), weights.size());
+    Random rng(Random::Engine::MT19937, 1);
+    size_t sum = 0;
+    while (state.keep_running()) {
+        sum += table.sample(rng);
+    }
+    Bench::do_not_optimize(sum);
+    state.set_items_processed(state.iterations());
+}
+
+void BM_CountWords(Bench::State& state) {
+    const std::string& text = sample_text(MB);
+    while (state.keep_running()) {
+        Bench::do_not_optimize(count_words(text));
+    }
+    state.set_bytes_processed(state.iterations() * text.size());
+}
+
+void BM_CountSentences(Bench::State& state) {
+    const std::string& text = sample_text(MB);
+    while (state.keep_running()) {
+        Bench::do_not_optimize(count_sentences(text));
+    }
+    state.set_bytes_processed(state.iterations() * text.size());
+}
+
+void BM_CountParagraphs(Bench::State& state) {
+    const std::string& text = sample_text(MB);
+    while (state.keep_running()) {
+        Bench::do_not_optimize(count_paragraphs(text));
+    }
+    state.set_bytes_processed(state.iterations() * text.size());
+}
+
+/* All counts in one pass; arg 1 forces the scalar kernel */
+void BM_CountText(Bench::State& state) {
+    const std::string& text = sample_text(MB);
+    while (state.keep_running()) {
+        TextStats stats = state.arg() ? Scan::count_text_scalar(text.data(), text.size())
+                                      : Scan::count_text(text.data(), text.size());
+        Bench::do_not_optimize(stats);
+    }
+    state.set_bytes_processed(state.iterations() * text.size());
+}
+
+/* Whitespace normalization as done by OutputWriter; arg selects paragraph mode */
+void BM_Normalize(Bench::State& state) {
+    const std::string& text = sample_text(MB);
+    NullBuffer null_buffer;
+    std::ostream null_stream(&null_buffer);
+    while (state.keep_running()) {
+        OutputWriter writer(null_stream, state.arg() != 0);
+        writer.write(text);
+        writer.finish();
+    }
+    state.set_bytes_processed(state.iterations() * text.size());
+}
+
+/* Normalization with --format markup around the paragraphs and sentences; arg is the Format */
+void BM_Format(Bench::State& state) {
+    const std::string& text = sample_text(MB);
+    NullBuffer null_buffer;
+    std::ostream null_stream(&null_buffer);
+    while (state.keep_running()) {
+        OutputWriter writer(null_stream, true);
+        writer.set_format(static_cast<Format>(state.arg()));
+        writer.write(text);
+        writer.finish();
+    }
+    state.set_bytes_processed(state.iterations() * text.size());
+}
+
+/* Normalization handing its buffers to an AsyncSink that writes to /dev/null */
+void BM_NormalizeSink(Bench::State& state) {
+    const std::string& text = sample_text(MB);
+    int fd = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+    if (fd < 0) {
+        std::perror("/dev/null");
+        std::exit(EXIT_FAILURE);
+    }
+    {
+        AsyncSink sink(fd, false);
+        while (state.keep_running()) {
+            OutputWriter writer(sink, true);
+            writer.write(text);
+            writer.finish();
+        }
+    }
+    ::close(fd);
+    state.set_bytes_processed(state.iterations() * text.size());
+}
+
+/**
+ * Runs the lipsum binary (LIPSUM_BIN, or ./lipsum) with @p args and counts its output.
+ **/
+void run_binary(Bench::State& state, const std::string& args) {
+    const char* binary = std::getenv("LIPSUM_BIN");
+    std::string command = std::string(binary ? binary : "./lipsum") + " --no-header " + args;
+    std::vector<char> buffer(1 << 20);
+    uint64_t bytes = 0;
+    while (state.keep_running()) {
+        FILE* pipe = popen(command.c_str(), "r");
+        if (pipe == nullptr) {
+            std::perror("popen");
+            std::exit(EXIT_FAILURE);
+        }
+        size_t n;
+        while ((n = std::fread(buffer.data(), 1, buffer.size(), pipe)) > 0) {
+            bytes += n;
+        }
+        if (pclose(pipe) != 0) {
+            std::fprintf(stderr, "Error: '%s' failed\n", command.c_str());
+            std::exit(EXIT_FAILURE);
+        }
+    }
+    state.set_bytes_processed(bytes);
+}
+
+void BM_EndToEndWords(Bench::State& state) {
+    long long words = static_cast<long long>(state.arg() / BYTES_PER_WORD);
+    run_binary(state, "-w " + std::to_string(words > 0 ? words : 1));
+}
+
+void BM_EndToEndParagraphs(Bench::State& state) {
+    long long paragraphs = static_cast<long long>(state.arg() / BYTES_PER_PARAGRAPH);
+    run_binary(state, "-p " + std::to_string(paragraphs > 0 ? paragraphs : 1));
+}
+
+void BM_EndToEndBytes(Bench::State& state) {
+    run_binary(state, "-b " + std::to_string(state.arg()));
+}
+
+int64_t select_arg(POS pos, char gender) {
+    return (static_cast<int64_t>(pos) << 8) | static_cast<unsigned char>(gender);
+}
+
+void register_all() {
+    Bench::register_benchmark("skeleton/simple", BM_Skeleton, static_cast<int64_t>(Mode::SIMPLE), "sentences");
+    Bench::register_benchmark("skeleton/normal", BM_Skeleton, static_cast<int64_t>(Mode::NORMAL), "sentences");
+    Bench::register_benchmark("skeleton/complex", BM_Skeleton, static_cast<int64_t>(Mode::COMPLEX), "sentences");
+    Bench::register_benchmark("skeleton/simple/cached", BM_Skeleton, static_cast<int64_t>(Mode::SIMPLE) | CACHED, "sentences");
+    Bench::register_benchmark("skeleton/normal/cached", BM_Skeleton, static_cast<int64_t>(Mode::NORMAL) | CACHED, "sentences");
+    Bench::register_benchmark("skeleton/complex/cached", BM_Skeleton, static_cast<int64_t>(Mode::COMPLEX) | CACHED, "sentences");
+
+    Bench::register_benchmark("fill_tokens", BM_FillTokens, 0, "sentences");
+
+    const int64_t mt19937 = static_cast<int64_t>(Random::Engine::MT19937);
+    const int64_t xoshiro = static_cast<int64_t>(Random::Engine::XOSHIRO256);
+    Bench::register_benchmark("sentence/mt19937", BM_Sentence, mt19937, "sentences");
+    Bench::register_benchmark("sentence/xoshiro256", BM_Sentence, xoshiro, "sentences");
+    Bench::register_benchmark("sentence_batch/1", BM_SentenceBatch, 1, "sentences");
+    Bench::register_benchmark("sentence_batch/64", BM_SentenceBatch, 64, "sentences");
+    Bench::register_benchmark("generator/paragraphs/1", BM_GeneratorParagraphs, 1, "calls");
+    Bench::register_benchmark("generator/paragraphs/100", BM_GeneratorParagraphs, 100, "calls");
+    Bench::register_benchmark("steady_state/sequential", BM_SteadyState, 0, "paragraphs");
+    Bench::register_benchmark("steady_state/threads/2", BM_SteadyState, 2, "paragraphs");
+    Bench::register_benchmark("markov_train/order2/1MB", BM_MarkovTrain, 2);
+    Bench::register_benchmark("markov_sentence/order1", BM_MarkovSentence, 1, "sentences");
+    Bench::register_benchmark("markov_sentence/order2", BM_MarkovSentence, 2, "sentences");
+    Bench::register_benchmark("markov_sentence/order3", BM_MarkovSentence, 3, "sentences");
+    Bench::register_benchmark("random_below/mt19937", BM_RandomBelow, mt19937, "draws");
+    Bench::register_benchmark("random_below/xoshiro256", BM_RandomBelow, xoshiro, "draws");
+
+    const struct { const char* name; POS pos; char gender; } selections[] = {
+        { "select_word/noun/m",        POS::NOUN,        'm' },
+        { "select_word/noun/f",        POS::NOUN,        'f' },
+        { "select_word/noun/n",        POS::NOUN,        'n' },
+        { "select_word/adjective/m",   POS::ADJECTIVE,   'm' },
+        { "select_word/adjective/f",   POS::ADJECTIVE,   'f' },
+        { "select_word/adjective/n",   POS::ADJECTIVE,   'n' },
+        { "select_word/verb/x",        POS::VERB,        'x' },
+        { "select_word/preposition/x", POS::PREPOSITION, 'x' },
+        { "select_word/conjunction/x", POS::CONJUNCTION, 'x' },
+    };
+    for (const auto& selection : selections) {
+        Bench::register_benchmark(selection.name, BM_SelectWord,
+                                  select_arg(selection.pos, selection.gender), "words");
+    }
+
+    Bench::register_benchmark("select_word/noun/m/weighted", BM_SelectWord,
+                              select_arg(POS::NOUN, 'm') | WEIGHTED, "words");
+    Bench::register_benchmark("select_word/verb/x/weighted", BM_SelectWord,
+                              select_arg(POS::VERB, 'x') | WEIGHTED, "words");
+    Bench::register_benchmark("alias_build/100k", BM_AliasBuild, 100000, "words");
+    Bench::register_benchmark("alias_sample/1k", BM_AliasSample, 1000, "words");
+    Bench::register_benchmark("alias_sample/100k", BM_AliasSample, 100000, "words");
+
+    Bench::register_benchmark("count_words/1MB", BM_CountWords);
+    Bench::register_benchmark("count_sentences/1MB", BM_CountSentences);
+    Bench::register_benchmark("count_paragraphs/1MB", BM_CountParagraphs);
+    Bench::register_benchmark("count_text/1MB", BM_CountText, 0);
+    Bench::register_benchmark("count_text/scalar/1MB", BM_CountText, 1);
+    Bench::register_benchmark("normalize/spaces/1MB", BM_Normalize, 0);
+    Bench::register_benchmark("normalize/paragraphs/1MB", BM_Normalize, 1);
+    Bench::register_benchmark("normalize/sink/1MB", BM_NormalizeSink, 0);
+    Bench::register_benchmark("format/html/1MB", BM_Format, static_cast<int64_t>(Format::HTML));
+    Bench::register_benchmark("format/markdown/1MB", BM_Format, static_cast<int64_t>(Format::MARKDOWN));
+    Bench::register_benchmark("format/json/1MB", BM_Format, static_cast<int64_t>(Format::JSON));
+
+    const struct { const char* suffix; int64_t bytes; bool large; } sizes[] = {
+        { "1KB", KB, false },
+        { "1MB", MB, false },
+        { "1GB", GB, true },
+    };
+    for (const auto& size : sizes) {
+        std::string suffix = std::string("/") + size.suffix;
+        Bench::register_benchmark("e2e/words" + suffix, BM_EndToEndWords, size.bytes, "items", true, size.large);
+        Bench::register_benchmark("e2e/paragraphs" + suffix, BM_EndToEndParagraphs, size.bytes, "items", true, size.large);
+        Bench::register_benchmark("e2e/bytes" + suffix, BM_EndToEndBytes, size.bytes, "items", true, size.large);
+    }
+}
+
+} /* namespace */
+
+int main(int argc, char* argv[]) {
+    register_all();
+#ifdef LIPSUM_STATS
+    Bench::set_allocation_counter(Stats::allocations);
+#endif
+    return Bench::run(argc, argv);
+}
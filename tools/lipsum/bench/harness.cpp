@@ -0,0 +1,224 @@
+#include "harness.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace Bench {
+
+namespace {
+
+struct Registration {
+    std::string name;
+    Function    function;
+    int64_t     arg;
+    std::string item_unit;
+    bool        single_shot;
+    bool        large;
+};
+
+struct Result {
+    std::string name;
+    uint64_t    iterations;
+    double      ns_per_iteration;
+    double      bytes_per_second;
+    double      items_per_second;
+    double      allocations_per_iteration; /* Negative without an allocation counter */
+    std::string item_unit;
+};
+
+std::vector<Registration>& registry() {
+    static std::vector<Registration> benchmarks;
+    return benchmarks;
+}
+
+uint64_t (*g_allocation_counter)() = nullptr;
+
+const double MIN_TIME_SECONDS = 0.5;
+const uint64_t MAX_ITERATIONS = 1000000000;
+
+/* Times one run; @p allocations receives the heap allocations its loop made, if counted */
+double run_once(const Registration& bench, uint64_t iterations, State& state, uint64_t& allocations) {
+    state = State(iterations, bench.arg, g_allocation_counter);
+    auto start = std::chrono::steady_clock::now();
+    bench.function(state);
+    auto end = std::chrono::steady_clock::now();
+    allocations = state.allocations();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+/**
+ * Runs @p bench with growing iteration counts until one run lasts MIN_TIME_SECONDS.
+ **/
+Result measure(const Registration& bench) {
+    State state(0, bench.arg);
+    uint64_t iterations = 1;
+    uint64_t allocations;
+    double seconds = run_once(bench, iterations, state, allocations);
+    while (!bench.single_shot && seconds < MIN_TIME_SECONDS && iterations < MAX_ITERATIONS) {
+        double scale = seconds > 0 ? (MIN_TIME_SECONDS * 1.4) / seconds : 10.0;
+        if (scale > 10.0) scale = 10.0;
+        if (scale < 2.0) scale = 2.0;
+        iterations = static_cast<uint64_t>(iterations * scale);
+        seconds = run_once(bench, iterations, state, allocations);
+    }
+
+    Result result;
+    result.name = bench.name;
+    result.iterations = iterations;
+    result.ns_per_iteration = seconds * 1e9 / iterations;
+    result.bytes_per_second = seconds > 0 ? state.bytes_processed() / seconds : 0;
+    result.items_per_second = seconds > 0 ? state.items_processed() / seconds : 0;
+    result.allocations_per_iteration = g_allocation_counter ? static_cast<double>(allocations) / iterations : -1;
+    result.item_unit = bench.item_unit;
+    return result;
+}
+
+std::string format_rate(double value, const std::string& unit) {
+    const char* suffix = "";
+    if (value >= 1e9) {
+        value /= 1e9;
+        suffix = "G";
+    } else if (value >= 1e6) {
+        value /= 1e6;
+        suffix = "M";
+    } else if (value >= 1e3) {
+        value /= 1e3;
+        suffix = "k";
+    }
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%.2f%s %s/s", value, suffix, unit.c_str());
+    return buffer;
+}
+
+/* Baseline files hold one "name<TAB>ns_per_iteration" line per benchmark */
+std::map<std::string, double> load_baseline(const std::string& path) {
+    std::map<std::string, double> baseline;
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Error: cannot read baseline " << path << "\n";
+        std::exit(EXIT_FAILURE);
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string name;
+        double ns;
+        if (std::getline(fields, name, '\t') && fields >> ns)
+            baseline[name] = ns;
+    }
+    return baseline;
+}
+
+const char* USAGE =
+    "Usage:\n"
+    "  lipsum_bench [options]\n\n"
+    "Options:\n"
+    "  --filter <text>     Only run benchmarks whose name contains this text.\n"
+    "  --large             Also run the 1 GB end-to-end benchmarks.\n"
+    "  --save <file>       Save the results as a baseline.\n"
+    "  --compare <file>    Compare the results against a saved baseline.\n"
+    "  --list              List benchmark names and exit.\n";
+
+} /* namespace */
+
+void set_allocation_counter(uint64_t (*counter)()) {
+    g_allocation_counter = counter;
+}
+
+bool register_benchmark(const std::string& name, Function function, int64_t arg,
+                        const std::string& item_unit, bool single_shot, bool large) {
+    registry().push_back({name, function, arg, item_unit, single_shot, large});
+    return true;
+}
+
+int run(int argc, char* argv[]) {
+    std::string filter, save_path, compare_path;
+    bool large = false, list = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--save" && i + 1 < argc) {
+            save_path = argv[++i];
+        } else if (arg == "--compare" && i + 1 < argc) {
+            compare_path = argv[++i];
+        } else if (arg == "--large") {
+            large = true;
+        } else if (arg == "--list") {
+            list = true;
+        } else {
+            std::cerr << USAGE;
+            return arg == "-h" ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    std::map<std::string, double> baseline;
+    if (!compare_path.empty())
+        baseline = load_baseline(compare_path);
+
+    if (!list) {
+        std::printf("%-36s %14s %12s %14s %22s %12s%s\n", "Benchmark", "Time", "Iterations", "Bytes",
+                    "Items", "Allocs/iter", baseline.empty() ? "" : "   vs baseline");
+        std::printf("%s\n", std::string(baseline.empty() ? 115 : 130, '-').c_str());
+    }
+
+    std::vector<Result> results;
+    for (const auto& bench : registry()) {
+        if (!filter.empty() && bench.name.find(filter) == std::string::npos)
+            continue;
+        if (bench.large && !large)
+            continue;
+        if (list) {
+            std::printf("%s\n", bench.name.c_str());
+            continue;
+        }
+
+        Result result = measure(bench);
+        results.push_back(result);
+
+        std::string bytes;
+        if (result.bytes_per_second > 0) {
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.1f MB/s", result.bytes_per_second / 1e6);
+            bytes = buffer;
+        }
+        std::string items = result.items_per_second > 0 ? format_rate(result.items_per_second, result.item_unit) : "";
+        std::string allocations;
+        if (result.allocations_per_iteration >= 0) {
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.2f", result.allocations_per_iteration);
+            allocations = buffer;
+        }
+        std::printf("%-36s %11.0f ns %12llu %14s %22s %12s", result.name.c_str(), result.ns_per_iteration,
+                    static_cast<unsigned long long>(result.iterations), bytes.c_str(), items.c_str(),
+                    allocations.c_str());
+
+        auto it = baseline.find(result.name);
+        if (it != baseline.end() && it->second > 0) {
+            double change = (result.ns_per_iteration - it->second) / it->second * 100.0;
+            std::printf("   %+7.1f%% %s", change, change > 0 ? "slower" : "faster");
+        }
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+
+    if (!save_path.empty()) {
+        std::ofstream out(save_path);
+        for (const auto& result : results) {
+            out << result.name << '\t' << result.ns_per_iteration << '\n';
+        }
+        if (!out) {
+            std::cerr << "Error: cannot write baseline " << save_path << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+} /* namespace Bench */
@@ -0,0 +1,90 @@
+#ifndef HARNESS_HPP
+#define HARNESS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @file harness.hpp
+ * @brief A small Google-Benchmark-style harness for lipsum's microbenchmarks.
+ *
+ * Benchmarks are plain functions that loop on State::keep_running() and report how many
+ * bytes and items (sentences, words, ...) they processed. The runner grows the iteration
+ * count until a run takes long enough to time, then prints time per iteration and
+ * throughput, optionally comparing against a baseline saved by an earlier run.
+ */
+
+namespace Bench {
+
+class State {
+public:
+    State(uint64_t iterations, int64_t arg, uint64_t (*allocation_counter)() = nullptr)
+        : m_remaining(iterations), m_iterations(iterations), m_arg(arg),
+          m_allocation_counter(allocation_counter) {}
+
+    bool keep_running() {
+        if (m_remaining == m_iterations && m_allocation_counter)
+            m_allocations_begin = m_allocation_counter();
+        if (m_remaining == 0) {
+            if (m_allocation_counter)
+                m_allocations = m_allocation_counter() - m_allocations_begin;
+            return false;
+        }
+        m_remaining--;
+        return true;
+    }
+
+    uint64_t iterations() const { return m_iterations; }
+
+    /* Argument the benchmark was registered with (e.g. an output size) */
+    int64_t arg() const { return m_arg; }
+
+    void set_bytes_processed(uint64_t bytes) { m_bytes = bytes; }
+    void set_items_processed(uint64_t items) { m_items = items; }
+
+    uint64_t bytes_processed() const { return m_bytes; }
+    uint64_t items_processed() const { return m_items; }
+
+    /* Heap allocations made inside the keep_running() loop, leaving out setup and teardown */
+    uint64_t allocations() const { return m_allocations; }
+
+private:
+    uint64_t m_remaining;
+    uint64_t m_iterations;
+    int64_t  m_arg;
+    uint64_t m_bytes = 0;
+    uint64_t m_items = 0;
+    uint64_t (*m_allocation_counter)();
+    uint64_t m_allocations_begin = 0;
+    uint64_t m_allocations = 0;
+};
+
+using Function = void (*)(State&);
+
+/**
+ * Registers a benchmark. @p single_shot benchmarks run exactly one iteration (end-to-end
+ * runs), and @p large ones only run when --large is given.
+ **/
+bool register_benchmark(const std::string& name, Function function, int64_t arg = 0,
+                        const std::string& item_unit = "items", bool single_shot = false,
+                        bool large = false);
+
+/**
+ * Has the runner report heap allocations per iteration, reading @p counter (a running
+ * total) when each timed run enters and leaves its keep_running() loop. Without one the
+ * column stays empty.
+ **/
+void set_allocation_counter(uint64_t (*counter)());
+
+int run(int argc, char* argv[]);
+
+/* Keeps the compiler from optimizing away a value the benchmark computes */
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+} /* namespace Bench */
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef LIPSUM_HPP
+#define LIPSUM_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+/**
+ * @file lipsum.hpp
+ * @brief Public interface of liblipsum, the text generator behind the lipsum tool.
+ *
+ * Link with -llipsum (static or shared) and -pthread. Nothing else from the source tree
+ * needs to be on the include path.
+ */
+
+/* The library is built with hidden visibility; only what is marked with this is exported */
+#if defined(__GNUC__)
+#define LIPSUM_API __attribute__((visibility("default")))
+#else
+#define LIPSUM_API
+#endif
+
+namespace Lipsum {
+
+/* What the count passed to Generator::generate() measures */
+enum class Unit {
+    WORDS,
+    SENTENCES,
+    PARAGRAPHS,
+    BYTES
+};
+
+enum class Complexity {
+    SIMPLE,
+    NORMAL,
+    COMPLEX
+};
+
+enum class Engine {
+    MT19937,    /* Same text per seed as the lipsum tool's default */
+    XOSHIRO256  /* Faster, different text per seed */
+};
+
+struct Settings {
+    Complexity  complexity = Complexity::NORMAL;
+    Engine      engine = Engine::MT19937;
+    bool        weighted = false;       /* Pick words in proportion to their frequency weights */
+    bool        skeleton_cache = false; /* Sample cached sentence structures; faster, other text */
+    std::string dict_path;              /* Binary dictionary file; empty for the built-in one */
+};
+
+/**
+ * @brief Owns a vocabulary and its indexes and generates text from it.
+ *
+ * Construction does all the setup work (mapping the dictionary file, building the alias
+ * tables for weighted selection), so create one Generator and keep it. Constructing
+ * Generators concurrently is safe, and generate() is const and keeps its random state
+ * per call, so any number of threads may share one Generator.
+ */
+class LIPSUM_API Generator {
+public:
+    /* Throws std::runtime_error if settings.dict_path cannot be loaded */
+    explicit Generator(const Settings& settings = Settings());
+    ~Generator();
+
+    Generator(Generator&&) noexcept;
+    Generator& operator=(Generator&&) noexcept;
+
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+
+    /**
+     * Appends @p count units of text generated from @p seed to @p out, so a buffer reused
+     * across calls keeps its capacity. The text is what `lipsum --no-header --seed <seed>`
+     * prints for the matching -w / -s / -p / -b flag, without the trailing newline:
+     * paragraphs are separated by blank lines, WORDS rounds up to whole sentences, and
+     * BYTES yields exactly @p count bytes, cut like -b cuts them. A seed of 0 is treated
+     * as 1, like the tool does.
+     **/
+    void generate(Unit unit, size_t count, unsigned int seed, std::string& out) const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} /* namespace Lipsum */
+
+#endif
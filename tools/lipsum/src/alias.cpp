@@ -0,0 +1,59 @@
+#include "alias.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+AliasTable::AliasTable(const float* weights, size_t count) {
+    build(weights, count);
+}
+
+AliasTable::AliasTable(const double* weights, size_t count) {
+    build(weights, count);
+}
+
+template <typename Weight>
+void AliasTable::build(const Weight* weights, size_t count) {
+    m_columns.resize(count);
+    double sum = 0.0;
+    for (size_t i = 0; weights != nullptr && i < count; i++) {
+        sum += weights[i];
+    }
+
+    /* Scale so the average column holds exactly 1, then pair light columns with heavy ones */
+    std::vector<double> scaled(count);
+    std::vector<uint32_t> light, heavy;
+    for (size_t i = 0; i < count; i++) {
+        scaled[i] = sum > 0.0 ? weights[i] * count / sum : 1.0;
+        m_columns[i] = { std::numeric_limits<uint32_t>::max(), static_cast<uint32_t>(i),
+                         static_cast<uint32_t>(i) };
+        (scaled[i] < 1.0 ? light : heavy).push_back(static_cast<uint32_t>(i));
+    }
+
+    while (!light.empty() && !heavy.empty()) {
+        uint32_t small = light.back();
+        uint32_t large = heavy.back();
+        light.pop_back();
+        double threshold = std::ldexp(scaled[small], 32);
+        m_columns[small].keep = static_cast<uint32_t>(
+            std::min(threshold, static_cast<double>(std::numeric_limits<uint32_t>::max())));
+        m_columns[small].alias = large;
+        scaled[large] -= 1.0 - scaled[small];
+        if (scaled[large] < 1.0) {
+            heavy.pop_back();
+            light.push_back(large);
+        }
+    }
+    /* Whatever is left is 1 up to rounding and keeps its own column */
+}
+
+WeightedIndex::WeightedIndex(const WordTable& table) {
+    for (size_t slot = 0; slot < POS_COUNT; slot++) {
+        const PosWords& words = table.parts[slot];
+        m_parts[slot] = AliasTable(words.weights, words.count);
+        m_genders[slot].reserve(words.gender_count);
+        for (size_t i = 0; i < words.gender_count; i++) {
+            const GenderSpan& span = words.genders[i];
+            m_genders[slot].emplace_back(span.weights, span.count);
+        }
+    }
+}
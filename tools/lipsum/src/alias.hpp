@@ -0,0 +1,80 @@
+#ifndef ALIAS_HPP
+#define ALIAS_HPP
+
+#include "random.hpp"
+#include "types.hpp"
+#include "wordtable.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Walker alias table: draws index i with probability weights[i] / sum in O(1).
+ *
+ * Built with Vose's method in O(n). A draw picks a column uniformly and then either keeps
+ * it or takes its alias, so sampling cost does not depend on the number of words.
+ */
+class AliasTable {
+public:
+    AliasTable() = default;
+
+    /**
+     * Builds the table for @p count weights, which must be finite and non-negative. A null
+     * @p weights, or weights that sum to zero, gives a uniform table.
+     **/
+    AliasTable(const float* weights, size_t count);
+
+    /* Same, for probabilities that need double precision */
+    AliasTable(const double* weights, size_t count);
+
+    size_t size() const { return m_columns.size(); }
+
+    /* Threshold and alias of column @p i, for tables stored elsewhere (see markov.cpp) */
+    uint32_t keep(size_t i) const { return m_columns[i].keep; }
+    uint32_t alias(size_t i) const { return m_columns[i].alias; }
+
+    size_t sample(Random& rng) const {
+        const Column& column = m_columns[rng.below(m_columns.size())];
+        return rng.bits() < column.keep ? column.index : column.alias;
+    }
+
+private:
+    /* Columns that are never aliased have alias == index, so their threshold is moot */
+    struct Column {
+        uint32_t keep;  /* Keep this column rather than its alias if 32 random bits are below this */
+        uint32_t index;
+        uint32_t alias;
+    };
+
+    std::vector<Column> m_columns;
+
+    template <typename Weight>
+    void build(const Weight* weights, size_t count);
+};
+
+/**
+ * @brief Alias tables for every part of speech and every (POS, gender) run of a WordTable.
+ *
+ * Built once from the table's weights and shared read-only by every Lexicon that selects
+ * from the same table, including the --threads workers.
+ */
+class WeightedIndex {
+public:
+    explicit WeightedIndex(const WordTable& table);
+
+    const AliasTable& part(POS part_of_speech) const {
+        return m_parts[static_cast<size_t>(part_of_speech)];
+    }
+
+    /* Table for words.genders[span] of @p part_of_speech */
+    const AliasTable& gender(POS part_of_speech, size_t span) const {
+        return m_genders[static_cast<size_t>(part_of_speech)][span];
+    }
+
+private:
+    std::array<AliasTable, POS_COUNT>              m_parts;
+    std::array<std::vector<AliasTable>, POS_COUNT> m_genders;
+};
+
+#endif
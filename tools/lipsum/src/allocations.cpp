@@ -0,0 +1,30 @@
+#include "stats.hpp"
+
+/*
+ * Counts heap allocations for --stats and lipsum_bench by replacing the global operator
+ * new. Only linked into the programs: the library must not replace its host program's
+ * allocator.
+ */
+
+#ifdef LIPSUM_STATS
+
+#include <cstdlib>
+#include <new>
+
+/* Global allocation hook; one relaxed increment, so it can count all the time */
+void* operator new(std::size_t size) {
+    Stats::count_allocation();
+    if (void* p = std::malloc(size > 0 ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+#endif
@@ -9,6 +9,8 @@
  * sentance skeleton. Each constant is annotated for customization.
  */
 
+#include <cstddef>
+
 namespace Config {
 
     /* Clause Count Configuration */
@@ -27,6 +29,32 @@ namespace Config {
     /* Verb Phrase (VP) Complexity: */
     constexpr double PROB_SIMPLE_VP = 0.60; /* probability of simple VP (verb only) */
     constexpr double PROB_COMPLEX_VP = 1.0 - PROB_SIMPLE_VP; /* probability of complex VP (verb + object NP) */
+
+    /* Parallel Generation (--threads) */
+    constexpr std::size_t PARALLEL_BLOCK_PARAGRAPHS = 64;  /* paragraphs per independently seeded block */
+    constexpr std::size_t PARALLEL_BLOCKS_PER_THREAD = 4;  /* how far workers may run ahead of the writer */
+    constexpr unsigned int MAX_THREADS_PER_CORE = 4;       /* --threads (and --serve workers) per hardware thread */
+
+    /* Server (--serve) */
+    constexpr int SERVER_REQUEST_SECONDS = 10; /* a client has this long to send its request line */
+    constexpr int SERVER_SEND_SECONDS = 30;    /* a client that leaves a send waiting this long is dropped */
+
+    /* Corpus Generation (--docs) */
+    constexpr std::size_t CORPUS_CHUNK_DOCS = 16;        /* documents a worker generates per claim */
+    constexpr std::size_t CORPUS_CHUNKS_PER_THREAD = 2;  /* how far workers may run ahead of the writer */
+
+    /* Markov Model (--model) */
+    constexpr std::size_t MARKOV_MAX_SENTENCE_WORDS = 100; /* longest generated sentence; longer ones are cut */
+
+    /* Batched Generation */
+    constexpr std::size_t SENTENCE_BATCH = 64; /* most sentences generated per batch */
+
+    /* Output Formats (--format) */
+    constexpr std::size_t FORMAT_SECTION_PARAGRAPHS = 8; /* paragraphs per heading; the middle one is a list */
+
+    /* Output */
+    constexpr std::size_t OUTPUT_BUFFER_SIZE = 1 << 20; /* bytes of normalized text buffered before each write */
+    constexpr std::size_t OUTPUT_BUFFERS = 3;           /* buffers the generator and the writer thread rotate through */
 }
 
 #endif
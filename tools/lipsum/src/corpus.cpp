@@ -0,0 +1,424 @@
+#include "corpus.hpp"
+#include "config.hpp"
+#include "generate.hpp"
+#include "output.hpp"
+#include "random.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+/* One document of a chunk, as the manifest lists it */
+struct Document {
+    uint32_t    seed;
+    std::string sizing; /* The sizing flags it was generated with, e.g. "-w 513" */
+    std::string file;   /* Its own file, relative to out_dir; empty when sharded */
+    size_t      length; /* Bytes, including the final newline */
+};
+
+/* Consecutive documents; their text back to back when sharded */
+struct Chunk {
+    std::string           text;
+    std::vector<Document> documents;
+    std::string           error; /* Set if a worker failed to write a document file */
+};
+
+bool write_all(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t written = ::write(fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        data += written;
+        length -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+/* MurmurHash3's 32-bit finalizer: a bijection, so distinct inputs give distinct outputs */
+uint32_t fmix32(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x85ebca6bu;
+    x ^= x >> 13;
+    x *= 0xc2b2ae35u;
+    x ^= x >> 16;
+    return x;
+}
+
+/* A size from [min, max], or min itself for a fixed size (max of -1) */
+template <typename T>
+T draw_size(Random& rng, T min, T max, SizeDistribution distribution) {
+    if (max <= min)
+        return min;
+    if (distribution == SizeDistribution::LOG_UNIFORM) {
+        double u = rng.uniform();
+        double low = std::log(static_cast<double>(min));
+        double high = std::log(static_cast<double>(max) + 1.0);
+        return std::clamp(static_cast<T>(std::exp(low + u * (high - low))), min, max);
+    }
+    return min + static_cast<T>(rng.below(static_cast<size_t>(max - min) + 1));
+}
+
+std::string sizing_flags(const Options& opts) {
+    std::string flags;
+    auto add = [&flags](const char* flag, long long value) {
+        if (value == -1)
+            return;
+        if (!flags.empty())
+            flags += ' ';
+        flags += flag;
+        flags += ' ';
+        flags += std::to_string(value);
+    };
+    add("-p", opts.paragraphs);
+    add("-s", opts.sentences);
+    add("-w", opts.words);
+    add("-c", opts.characters);
+    if (opts.byte_exclusive)
+        add("-b", opts.bytes);
+    return flags;
+}
+
+/* "000042.txt": zero-padded to the width of the last document number */
+std::string document_file(uint64_t doc, uint64_t docs) {
+    int width = static_cast<int>(std::to_string(docs > 1 ? docs - 1 : 0).size());
+    char name[48];
+    std::snprintf(name, sizeof(name), "%0*llu.txt", width, static_cast<unsigned long long>(doc));
+    return name;
+}
+
+std::string shard_file(uint64_t shard) {
+    char name[48];
+    std::snprintf(name, sizeof(name), "shard-%05llu.txt", static_cast<unsigned long long>(shard));
+    return name;
+}
+
+/**
+ * @brief Generates the documents in chunks of Config::CORPUS_CHUNK_DOCS on a pool of
+ * worker threads.
+ *
+ * Workers claim chunks in order and run at most a few chunks ahead of take(), like
+ * ParallelSource does with its blocks. Unsharded, each worker writes its documents'
+ * files itself, so only the manifest entries travel back.
+ */
+class Corpus {
+public:
+    Corpus(const Options& opts, const WordTable& table, const WeightedIndex* weighted, unsigned int threads)
+        : m_opts(opts), m_table(table), m_weighted(weighted),
+          m_chunks((static_cast<uint64_t>(opts.docs) + Config::CORPUS_CHUNK_DOCS - 1) / Config::CORPUS_CHUNK_DOCS) {
+        if (threads == 0)
+            threads = 1;
+        m_slots.resize(static_cast<size_t>(threads) * Config::CORPUS_CHUNKS_PER_THREAD);
+        m_workers.reserve(threads);
+        for (unsigned int i = 0; i < threads; i++) {
+            m_workers.emplace_back(&Corpus::worker, this);
+        }
+    }
+
+    ~Corpus() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_space.notify_all();
+        for (auto& thread : m_workers) {
+            thread.join();
+        }
+    }
+
+    Corpus(const Corpus&) = delete;
+    Corpus& operator=(const Corpus&) = delete;
+
+    uint64_t chunk_count() const { return m_chunks; }
+
+    /* Waits for the next chunk in order and swaps it into @p chunk */
+    void take(Chunk& chunk) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            Slot& slot = m_slots[m_next_consume % m_slots.size()];
+            m_ready.wait(lock, [&] { return slot.ready && slot.chunk == m_next_consume; });
+            std::swap(chunk, slot.data);
+            slot.ready = false;
+            m_next_consume++;
+        }
+        m_space.notify_all();
+    }
+
+private:
+    struct Slot {
+        uint64_t chunk = 0;
+        bool     ready = false;
+        Chunk    data;
+    };
+
+    const Options&           m_opts;
+    const WordTable&         m_table;
+    const WeightedIndex*     m_weighted;
+    uint64_t                 m_chunks;
+
+    std::mutex               m_mutex;
+    std::condition_variable  m_ready;
+    std::condition_variable  m_space;
+    std::vector<Slot>        m_slots; /* Chunk c lives in slot c % m_slots.size() */
+    uint64_t                 m_next_claim = 0;
+    uint64_t                 m_next_consume = 0;
+    bool                     m_stop = false;
+    std::vector<std::thread> m_workers;
+
+    /* What a worker reuses from one document to the next */
+    struct Scratch {
+        std::string  text;   /* The document being written, unsharded */
+        StringBuffer buffer{ text };
+        std::ostream out{ &buffer };
+        OutputWriter writer;
+        Random       sizes{ Random::Engine::XOSHIRO256 };
+
+        explicit Scratch(bool keep_paragraphs) : writer(out, keep_paragraphs) {}
+    };
+
+    void worker() {
+        /* The options of one document: the run's, with the corpus flags taken out */
+        Options doc = m_opts;
+        doc.docs = 0;
+        doc.out_dir.clear();
+        doc.shard_size = 0;
+        doc.parallel = false;
+        Scratch scratch(!doc.no_paragraph);
+        Chunk chunk;
+
+        while (true) {
+            uint64_t index;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_space.wait(lock, [this] {
+                    return m_stop || m_next_claim >= m_chunks ||
+                           m_next_claim < m_next_consume + m_slots.size();
+                });
+                if (m_stop || m_next_claim >= m_chunks)
+                    return;
+                index = m_next_claim++;
+            }
+
+            generate_chunk(index, chunk, doc, scratch);
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                Slot& slot = m_slots[index % m_slots.size()];
+                std::swap(slot.data, chunk);
+                slot.chunk = index;
+                slot.ready = true;
+            }
+            m_ready.notify_all();
+        }
+    }
+
+    void generate_chunk(uint64_t index, Chunk& chunk, Options& doc, Scratch& scratch) {
+        const bool sharded = m_opts.shard_size > 0;
+        const uint64_t docs = static_cast<uint64_t>(m_opts.docs);
+        const uint64_t first = index * Config::CORPUS_CHUNK_DOCS;
+        const uint64_t last = std::min(first + Config::CORPUS_CHUNK_DOCS, docs);
+        const unsigned int seed = m_opts.seed != 0 ? m_opts.seed : 1;
+
+        chunk.text.clear();
+        chunk.documents.clear();
+        chunk.error.clear();
+        for (uint64_t i = first; i < last && chunk.error.empty(); i++) {
+            doc.seed = document_seed(seed, i);
+            Random& sizes = scratch.sizes;
+            sizes.seed_stream(seed, i);
+            SizeDistribution distribution = m_opts.size_distribution;
+            doc.paragraphs = draw_size(sizes, m_opts.paragraphs, m_opts.paragraphs_max, distribution);
+            doc.sentences = draw_size(sizes, m_opts.sentences, m_opts.sentences_max, distribution);
+            doc.words = draw_size(sizes, m_opts.words, m_opts.words_max, distribution);
+            doc.characters = draw_size(sizes, m_opts.characters, m_opts.characters_max, distribution);
+            doc.bytes = draw_size(sizes, m_opts.bytes, m_opts.bytes_max, distribution);
+
+            std::string& text = sharded ? chunk.text : scratch.text;
+            size_t begin = sharded ? text.size() : 0;
+            if (!sharded)
+                text.clear();
+            scratch.buffer.target(text);
+            scratch.writer.reset();
+            generate_text(doc, m_table, m_weighted, scratch.writer);
+
+            Document entry{ doc.seed, sizing_flags(doc), std::string(), text.size() - begin };
+            if (!sharded) {
+                entry.file = document_file(i, docs);
+                std::string path = m_opts.out_dir + "/" + entry.file;
+                int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+                if (fd < 0 || !write_all(fd, text.data(), text.size()))
+                    chunk.error = "cannot write " + path + ": " + std::strerror(errno);
+                if (fd >= 0 && ::close(fd) != 0 && chunk.error.empty())
+                    chunk.error = "cannot write " + path + ": " + std::strerror(errno);
+            }
+            chunk.documents.push_back(std::move(entry));
+        }
+    }
+};
+
+/**
+ * @brief Appends chunks to shard files, starting a new shard whenever the next document
+ * would not fit. Each run of documents bound for the same shard goes out in one write.
+ */
+class ShardWriter {
+public:
+    ShardWriter(const std::string& directory, uint64_t shard_size)
+        : m_directory(directory), m_shard_size(shard_size) {}
+
+    ~ShardWriter() {
+        if (m_fd >= 0)
+            ::close(m_fd);
+    }
+
+    ShardWriter(const ShardWriter&) = delete;
+    ShardWriter& operator=(const ShardWriter&) = delete;
+
+    /**
+     * Writes @p chunk and fills in where each document went. Returns false with @p error
+     * set on failure.
+     **/
+    bool write(const Chunk& chunk, std::vector<std::pair<std::string, uint64_t>>& places,
+               std::string& error) {
+        places.clear();
+        size_t position = 0, pending = 0;
+        for (const Document& document : chunk.documents) {
+            if (m_fd < 0 || (m_offset > 0 && m_offset + document.length > m_shard_size)) {
+                if (!flush(chunk.text, pending, position, error) || !next_shard(error))
+                    return false;
+                pending = position;
+            }
+            places.emplace_back(m_name, m_offset);
+            m_offset += document.length;
+            position += document.length;
+        }
+        return flush(chunk.text, pending, position, error);
+    }
+
+    bool close(std::string& error) {
+        int fd = m_fd;
+        m_fd = -1;
+        if (fd >= 0 && ::close(fd) != 0) {
+            error = "cannot write " + path() + ": " + std::strerror(errno);
+            return false;
+        }
+        return true;
+    }
+
+private:
+    std::string m_directory;
+    uint64_t    m_shard_size;
+    int         m_fd = -1;
+    uint64_t    m_shards = 0;
+    std::string m_name;
+    uint64_t    m_offset = 0;
+
+    std::string path() const { return m_directory + "/" + m_name; }
+
+    bool flush(const std::string& text, size_t begin, size_t end, std::string& error) {
+        if (end > begin && !write_all(m_fd, text.data() + begin, end - begin)) {
+            error = "cannot write " + path() + ": " + std::strerror(errno);
+            return false;
+        }
+        return true;
+    }
+
+    bool next_shard(std::string& error) {
+        if (!close(error))
+            return false;
+        m_name = shard_file(m_shards++);
+        m_offset = 0;
+        m_fd = ::open(path().c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (m_fd < 0) {
+            error = "cannot write " + path() + ": " + std::strerror(errno);
+            return false;
+        }
+        return true;
+    }
+};
+
+} /* namespace */
+
+/**
+ * Consecutive documents get consecutive inputs to a bijective mixer, offset by a mix of
+ * the corpus seed. The one input that maps to 0 is swapped for the input of document
+ * 2^32 - 1, which --docs never reaches.
+ **/
+uint32_t document_seed(unsigned int seed, uint64_t doc) {
+    uint32_t base = fmix32(seed ^ 0x9e3779b9u);
+    uint32_t input = base + static_cast<uint32_t>(doc);
+    if (input == 0)
+        input = base - 1;
+    return fmix32(input);
+}
+
+int run_corpus(const Options& opts, const WordTable& table, const WeightedIndex* weighted) {
+    if (::mkdir(opts.out_dir.c_str(), 0755) != 0 && errno != EEXIST) {
+        std::cerr << "Error: cannot create " << opts.out_dir << ": " << std::strerror(errno) << "\n";
+        return EXIT_FAILURE;
+    }
+    struct stat info;
+    if (::stat(opts.out_dir.c_str(), &info) != 0 || !S_ISDIR(info.st_mode)) {
+        std::cerr << "Error: " << opts.out_dir << " is not a directory.\n";
+        return EXIT_FAILURE;
+    }
+
+    const std::string manifest_path = opts.out_dir + "/manifest.tsv";
+    std::ofstream manifest(manifest_path);
+    manifest << "doc\tseed\tsizing\tfile\toffset\tlength\n";
+
+    unsigned int threads = opts.parallel ? opts.threads : 0;
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::string error;
+    {
+        Corpus corpus(opts, table, weighted, threads);
+        ShardWriter shards(opts.out_dir, static_cast<uint64_t>(opts.shard_size));
+        std::vector<std::pair<std::string, uint64_t>> places;
+        Chunk chunk;
+        uint64_t doc = 0;
+        for (uint64_t c = 0; c < corpus.chunk_count() && error.empty() && manifest; c++) {
+            corpus.take(chunk);
+            error = chunk.error;
+            if (!error.empty() || (opts.shard_size > 0 && !shards.write(chunk, places, error)))
+                break;
+            for (size_t k = 0; k < chunk.documents.size(); k++, doc++) {
+                const Document& document = chunk.documents[k];
+                manifest << doc << '\t' << document.seed << '\t' << document.sizing << '\t';
+                if (opts.shard_size > 0)
+                    manifest << places[k].first << '\t' << places[k].second;
+                else
+                    manifest << document.file << "\t0";
+                manifest << '\t' << document.length << '\n';
+            }
+        }
+        if (error.empty())
+            shards.close(error);
+    }
+
+    manifest.close();
+    if (error.empty() && !manifest)
+        error = "cannot write " + manifest_path;
+    if (!error.empty()) {
+        std::cerr << "Error: " << error << "\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
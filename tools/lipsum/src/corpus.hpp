@@ -0,0 +1,41 @@
+#ifndef CORPUS_HPP
+#define CORPUS_HPP
+
+#include "alias.hpp"
+#include "options.hpp"
+#include "wordtable.hpp"
+#include <cstdint>
+
+/**
+ * @file corpus.hpp
+ * @brief --docs: many independent documents from one process.
+ *
+ * Document i is exactly what `lipsum <sizing> --seed document_seed(seed, i)` prints with
+ * the run's other options, where the sizing flags are drawn per document when they are
+ * given as ranges. Workers generate documents in chunks and the main thread commits the
+ * chunks in order, so the files and the manifest depend only on the options, not on the
+ * number of threads.
+ *
+ * out_dir/manifest.tsv has a header line and then one line per document:
+ *
+ *   doc  seed  sizing  file  offset  length
+ *
+ * Without --shard-size every document is its own file (offset 0). With it, documents are
+ * appended to shard-NNNNN.txt files, and a new shard starts before a document that would
+ * take the current one past the shard size.
+ */
+
+/**
+ * The --seed of document @p doc in a corpus generated from @p seed. Distinct for every
+ * doc below 2^32 - 1 and never 0, so no two documents share their text by accident.
+ **/
+uint32_t document_seed(unsigned int seed, uint64_t doc);
+
+/**
+ * Writes opts.docs documents and the manifest into opts.out_dir (created if missing),
+ * on opts.threads threads (all hardware threads unless --threads was given). @p weighted
+ * must be built from @p table when opts.weighted is set. Returns the exit status.
+ **/
+int run_corpus(const Options& opts, const WordTable& table, const WeightedIndex* weighted);
+
+#endif
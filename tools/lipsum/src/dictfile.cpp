@@ -0,0 +1,128 @@
+#include "dictfile.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+std::runtime_error format_error(const std::string& path, const std::string& what) {
+    return std::runtime_error("dictionary file " + path + ": " + what);
+}
+
+bool section_fits(size_t file_size, uint64_t offset, uint64_t count, uint64_t width) {
+    return offset <= file_size && count * width <= file_size - offset;
+}
+
+} /* namespace */
+
+MappedDictionary::MappedDictionary(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw format_error(path, std::strerror(errno));
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        int err = errno;
+        ::close(fd);
+        throw format_error(path, std::strerror(err));
+    }
+    m_size = static_cast<size_t>(info.st_size);
+    if (m_size < sizeof(DictFileHeader)) {
+        ::close(fd);
+        throw format_error(path, "too small to be a dictionary");
+    }
+
+    m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (m_data == MAP_FAILED) {
+        m_data = nullptr;
+        throw format_error(path, std::strerror(errno));
+    }
+
+    try {
+        index(path);
+    } catch (...) {
+        ::munmap(m_data, m_size);
+        throw;
+    }
+}
+
+MappedDictionary::~MappedDictionary() {
+    if (m_data != nullptr)
+        ::munmap(m_data, m_size);
+}
+
+/**
+ * Validates the mapped file and points the word table into it.
+ **/
+void MappedDictionary::index(const std::string& path) {
+    const char* base = static_cast<const char*>(m_data);
+    const auto* header = reinterpret_cast<const DictFileHeader*>(base);
+
+    if (std::memcmp(header->magic, DICT_FILE_MAGIC, sizeof(DICT_FILE_MAGIC)) != 0)
+        throw format_error(path, "not a lipsum dictionary");
+    if (header->version != 1 && header->version != DICT_FILE_VERSION)
+        throw format_error(path, "unsupported version " + std::to_string(header->version));
+    if (!section_fits(m_size, header->runs_offset, header->run_count, sizeof(DictFileRun)) ||
+        !section_fits(m_size, header->entries_offset, header->entry_count, sizeof(DictFileEntry)) ||
+        !section_fits(m_size, header->pool_offset, header->pool_size, 1) ||
+        header->runs_offset % alignof(DictFileRun) != 0 ||
+        header->entries_offset % alignof(DictFileEntry) != 0)
+        throw format_error(path, "section out of bounds");
+    bool has_weights = header->version >= 2;
+    if (has_weights &&
+        (!section_fits(m_size, header->weights_offset, header->entry_count, sizeof(float)) ||
+         header->weights_offset % alignof(float) != 0))
+        throw format_error(path, "section out of bounds");
+
+    const auto* runs = reinterpret_cast<const DictFileRun*>(base + header->runs_offset);
+    const auto* entries = reinterpret_cast<const DictFileEntry*>(base + header->entries_offset);
+    const char* pool = base + header->pool_offset;
+    const float* weights =
+        has_weights ? reinterpret_cast<const float*>(base + header->weights_offset) : nullptr;
+
+    m_words.reserve(header->entry_count);
+    for (uint32_t i = 0; i < header->entry_count; i++) {
+        const DictFileEntry& entry = entries[i];
+        if (entry.offset > header->pool_size || entry.length > header->pool_size - entry.offset)
+            throw format_error(path, "word " + std::to_string(i) + " out of bounds");
+        m_words.emplace_back(pool + entry.offset, entry.length);
+        m_table.longest_word = std::max<size_t>(m_table.longest_word, entry.length);
+        if (weights != nullptr && !(std::isfinite(weights[i]) && weights[i] >= 0.0f))
+            throw format_error(path, "bad weight for word " + std::to_string(i));
+    }
+
+    /* Runs must tile the entries in (pos, gender) order; an empty one could be selected */
+    uint32_t expected = 0;
+    m_genders.reserve(header->run_count);
+    for (uint32_t i = 0; i < header->run_count; i++) {
+        const DictFileRun& run = runs[i];
+        if (run.pos >= POS_COUNT || run.first != expected || run.count == 0 ||
+            run.count > header->entry_count - run.first)
+            throw format_error(path, "bad run " + std::to_string(i));
+        if (i > 0 && run.pos < runs[i - 1].pos)
+            throw format_error(path, "runs not sorted by part of speech");
+        expected = run.first + run.count;
+        m_genders.push_back({run.gender, m_words.data() + run.first, run.count,
+                             weights != nullptr ? weights + run.first : nullptr});
+    }
+    if (expected != header->entry_count)
+        throw format_error(path, "runs do not cover every entry");
+
+    for (uint32_t i = 0; i < header->run_count; i++) {
+        PosWords& part = m_table.parts[runs[i].pos];
+        if (part.gender_count == 0) {
+            part.words = m_genders[i].words;
+            part.weights = m_genders[i].weights;
+            part.genders = &m_genders[i];
+        }
+        part.count += m_genders[i].count;
+        part.gender_count++;
+    }
+}
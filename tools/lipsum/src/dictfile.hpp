@@ -0,0 +1,89 @@
+#ifndef DICTFILE_HPP
+#define DICTFILE_HPP
+
+#include "wordtable.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file dictfile.hpp
+ * @brief On-disk dictionary format and its memory-mapped loader.
+ *
+ * Layout (little-endian, every section 4-byte aligned):
+ *
+ *   DictFileHeader
+ *   DictFileRun   runs[run_count]       sorted by (pos, gender)
+ *   DictFileEntry entries[entry_count]  grouped to match the runs
+ *   float         weights[entry_count]  finite, non-negative frequency weights (version 2)
+ *   char          pool[pool_size]       word bytes, not NUL-terminated
+ *
+ * Each run names the non-empty range of entries [first, first + count) that share one POS
+ * and gender, and the runs of a POS are contiguous, so the whole POS is one entry range
+ * as well. Files are produced by src/make_binary_dict.py from the scraper's output.
+ * Version 1 files have no weights section and load with every word weighted equally.
+ */
+
+constexpr char     DICT_FILE_MAGIC[8] = { 'L', 'I', 'P', 'S', 'D', 'I', 'C', 'T' };
+constexpr uint32_t DICT_FILE_VERSION = 2;
+
+struct DictFileHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t run_count;
+    uint32_t entry_count;
+    uint32_t pool_size;
+    uint32_t runs_offset;
+    uint32_t entries_offset;
+    uint32_t pool_offset;
+    uint32_t weights_offset; /* 0 in version 1 files */
+};
+
+struct DictFileRun {
+    uint8_t  pos;      /* static_cast<uint8_t>(POS) */
+    char     gender;
+    uint16_t reserved;
+    uint32_t first;
+    uint32_t count;
+};
+
+struct DictFileEntry {
+    uint32_t offset;   /* into the string pool */
+    uint32_t length;
+};
+
+static_assert(sizeof(DictFileHeader) == 40, "DictFileHeader must match the file layout");
+static_assert(sizeof(DictFileRun) == 12, "DictFileRun must match the file layout");
+static_assert(sizeof(DictFileEntry) == 8, "DictFileEntry must match the file layout");
+
+/**
+ * @brief A dictionary file mapped read-only into memory and exposed as a WordTable.
+ *
+ * Words are used in place: the table's views point straight into the mapping, and the
+ * only work done at load time is checking the header and turning entries into views.
+ * Throws std::runtime_error if the file can't be mapped or is malformed.
+ */
+class MappedDictionary {
+public:
+    explicit MappedDictionary(const std::string& path);
+
+    ~MappedDictionary();
+
+    MappedDictionary(const MappedDictionary&) = delete;
+    MappedDictionary& operator=(const MappedDictionary&) = delete;
+
+    const WordTable& table() const { return m_table; }
+
+private:
+    void*                         m_data = nullptr;
+    size_t                        m_size = 0;
+    std::vector<std::string_view> m_words;
+    std::vector<GenderSpan>       m_genders;
+    WordTable                     m_table;
+
+    void index(const std::string& path);
+};
+
+#endif
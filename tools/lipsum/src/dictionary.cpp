@@ -1,1090 +1,1242 @@
 #include "dictionary.hpp"
 #include "types.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <string_view>
 #include <unordered_map>
 
-Dictionary get_debug_dictionary() {
-    Dictionary dict;
+/*
+ * The built-in vocabularies are constexpr tables, regrouped by gender at compile time,
+ * so Lexicon can select from them directly without building anything at startup.
+ */
 
-    dict[POS::NOUN] = {
-        {"noun-f", POS::NOUN, 'f'},
-        {"noun-m", POS::NOUN, 'm'},
-        {"noun-n", POS::NOUN, 'n'}
-    };
+namespace {
 
-    dict[POS::ADJECTIVE] = {
-        {"adj-m", POS::ADJECTIVE, 'm'},
-        {"adj-f", POS::ADJECTIVE, 'f'},
-        {"adj-n", POS::ADJECTIVE, 'n'}
-    };
+/* One entry as written by latin_dict_scraper.py */
+struct StaticWord {
+    std::string_view text;
+    POS              pos;
+    char             gender;
+    float            weight = 0.0f; /* 0: derive it from the word's rank, see rank_weight() */
+};
 
-    dict[POS::VERB] = {
-        {"verb-1", POS::VERB, 'n'},
-        {"verb-2", POS::VERB, 'n'}
-    };
+/**
+ * The lists below are in the scraper's frequency order, so a word without an explicit
+ * weight gets a Zipfian 1 / rank, with rank being its position in its list.
+ */
+constexpr float rank_weight(const StaticWord& word, size_t index) {
+    return word.weight > 0.0f ? word.weight : 1.0f / static_cast<float>(index + 1);
+}
 
-    dict[POS::ADVERB] = {
-        {"adverb-1", POS::ADVERB, 'n'}
-    };
+constexpr StaticWord DEBUG_NOUNS[] = {
+    {"noun-f", POS::NOUN, 'f'},
+    {"noun-m", POS::NOUN, 'm'},
+    {"noun-n", POS::NOUN, 'n'}
+};
 
-    dict[POS::PREPOSITION] = {
-        {"prep", POS::PREPOSITION, 'n'}
-    };
+constexpr StaticWord DEBUG_ADJECTIVES[] = {
+    {"adj-m", POS::ADJECTIVE, 'm'},
+    {"adj-f", POS::ADJECTIVE, 'f'},
+    {"adj-n", POS::ADJECTIVE, 'n'}
+};
 
-    dict[POS::CONJUNCTION] = {
-        {"conj", POS::CONJUNCTION, 'n'},
-        {"conj", POS::CONJUNCTION, 'n'}
-    };
+constexpr StaticWord DEBUG_VERBS[] = {
+    {"verb-1", POS::VERB, 'n'},
+    {"verb-2", POS::VERB, 'n'}
+};
 
-    return dict;
+constexpr StaticWord DEBUG_ADVERBS[] = {
+    {"adverb-1", POS::ADVERB, 'n'}
+};
+
+constexpr StaticWord DEBUG_PREPOSITIONS[] = {
+    {"prep", POS::PREPOSITION, 'n'}
+};
+
+constexpr StaticWord DEBUG_CONJUNCTIONS[] = {
+    {"conj", POS::CONJUNCTION, 'n'},
+    {"conj", POS::CONJUNCTION, 'n'}
+};
+
+constexpr StaticWord TEST_NOUNS[] = {
+    {"res", POS::NOUN, 'n' },
+    {"homo", POS::NOUN, 'n' },
+    {"pars", POS::NOUN, 'n' },
+    {"causa", POS::NOUN, 'f' },
+    {"tempus", POS::NOUN, 'm' },
+    {"nomen", POS::NOUN, 'n' },
+    {"filius", POS::NOUN, 'm' },
+    {"dies", POS::NOUN, 'n' },
+    {"locus", POS::NOUN, 'm' },
+    {"modus", POS::NOUN, 'm' },
+    {"rex", POS::NOUN, 'n' },
+    {"deus", POS::NOUN, 'm' },
+    {"terra", POS::NOUN, 'f' },
+    {"pater", POS::NOUN, 'm' },
+    {"corpus", POS::NOUN, 'm' },
+    {"opus", POS::NOUN, 'm' },
+    {"populus", POS::NOUN, 'm' },
+    {"liber", POS::NOUN, 'm' },
+    {"bonum", POS::NOUN, 'n' },
+    {"genus", POS::NOUN, 'm' },
+    {"animus", POS::NOUN, 'm' },
+    {"dominus", POS::NOUN, 'm' },
+    {"bellum", POS::NOUN, 'n' },
+    {"lex", POS::NOUN, 'n' },
+    {"ius", POS::NOUN, 'm' },
+    {"ratio", POS::NOUN, 'n' },
+    {"fides", POS::NOUN, 'n' },
+    {"manus", POS::NOUN, 'm' },
+    {"annus", POS::NOUN, 'm' },
+    {"exercitus", POS::NOUN, 'm' },
+    {"natura", POS::NOUN, 'f' },
+    {"domus", POS::NOUN, 'm' },
+    {"actio", POS::NOUN, 'n' },
+    {"mors", POS::NOUN, 'n' },
+    {"malum", POS::NOUN, 'n' },
+    {"miles", POS::NOUN, 'n' },
+    {"gens", POS::NOUN, 'n' },
+    {"castra", POS::NOUN, 'f' },
+    {"Deus", POS::NOUN, 'm' },
+    {"iudicium", POS::NOUN, 'n' },
+    {"mens", POS::NOUN, 'n' },
+    {"frater", POS::NOUN, 'm' },
+    {"dux", POS::NOUN, 'n' },
+    {"pecunia", POS::NOUN, 'f' },
+    {"consilium", POS::NOUN, 'n' },
+    {"ordo", POS::NOUN, 'n' },
+    {"caelum", POS::NOUN, 'n' },
+    {"iudex", POS::NOUN, 'n' },
+    {"cor", POS::NOUN, 'm' },
+    {"mater", POS::NOUN, 'm' },
+    {"mos", POS::NOUN, 'n' },
+    {"regnum", POS::NOUN, 'n' },
+    {"sententia", POS::NOUN, 'f' },
+    {"gratia", POS::NOUN, 'f' },
+    {"usus", POS::NOUN, 'm' },
+    {"finis", POS::NOUN, 'n' },
+    {"heres", POS::NOUN, 'n' },
+    {"anima", POS::NOUN, 'f' },
+    {"officium", POS::NOUN, 'n' },
+    {"potestas", POS::NOUN, 'n' },
+    {"ager", POS::NOUN, 'm' },
+    {"oculus", POS::NOUN, 'm' },
+    {"urbs", POS::NOUN, 'n' },
+    {"labor", POS::NOUN, 'm' },
+    {"persona", POS::NOUN, 'f' },
+    {"Dominus", POS::NOUN, 'm' },
+    {"aqua", POS::NOUN, 'f' },
+    {"littera", POS::NOUN, 'f' },
+    {"caro", POS::NOUN, 'n' },
+    {"ignis", POS::NOUN, 'n' },
+    {"Deo", POS::NOUN, 'n' },
+    {"principium", POS::NOUN, 'n' },
+    {"uxor", POS::NOUN, 'm' },
+    {"urbis", POS::NOUN, 'n' },
+    {"species", POS::NOUN, 'n' },
+    {"honor", POS::NOUN, 'm' },
+    {"pax", POS::NOUN, 'n' },
+    {"amicus", POS::NOUN, 'm' },
+    {"hereditas", POS::NOUN, 'n' },
+    {"spiritus", POS::NOUN, 'm' },
+    {"legatum", POS::NOUN, 'n' },
+    {"ars", POS::NOUN, 'n' },
+    {"libertas", POS::NOUN, 'n' },
+    {"fructus", POS::NOUN, 'm' },
+    {"aetas", POS::NOUN, 'n' },
+    {"possessio", POS::NOUN, 'n' },
+    {"mulier", POS::NOUN, 'm' },
+    {"sanguis", POS::NOUN, 'n' },
+    {"pes", POS::NOUN, 'n' },
+    {"nox", POS::NOUN, 'n' },
+    {"lux", POS::NOUN, 'n' },
+    {"senatus", POS::NOUN, 'm' },
+    {"signum", POS::NOUN, 'n' },
+    {"spes", POS::NOUN, 'n' },
+    {"os", POS::NOUN, 'n' },
+    {"peccatum", POS::NOUN, 'n' },
+    {"imperator", POS::NOUN, 'm' },
+    {"auctor", POS::NOUN, 'm' },
+    {"mons", POS::NOUN, 'n' },
+    {"testamentum", POS::NOUN, 'n' },
+    {"sermo", POS::NOUN, 'n' },
+    {"imperium", POS::NOUN, 'n' },
+    {"numerus", POS::NOUN, 'm' },
+    {"sensus", POS::NOUN, 'm' },
+    {"Domini", POS::NOUN, 'n' },
+    {"forma", POS::NOUN, 'f' },
+    {"oratio", POS::NOUN, 'n' },
+    {"fortuna", POS::NOUN, 'f' },
+    {"arma", POS::NOUN, 'f' },
+    {"gloria", POS::NOUN, 'f' },
+    {"poena", POS::NOUN, 'f' },
+    {"sapientia", POS::NOUN, 'f' },
+    {"fundus", POS::NOUN, 'm' },
+    {"forte", POS::NOUN, 'n' },
+    {"cura", POS::NOUN, 'f' },
+    {"scientia", POS::NOUN, 'f' },
+    {"salus", POS::NOUN, 'm' },
+    {"Deum", POS::NOUN, 'n' },
+    {"mundus", POS::NOUN, 'm' },
+    {"consul", POS::NOUN, 'n' },
+    {"equus", POS::NOUN, 'm' },
+    {"pretium", POS::NOUN, 'n' },
+    {"caput", POS::NOUN, 'n' },
+    {"amor", POS::NOUN, 'm' },
+    {"auctoritas", POS::NOUN, 'n' },
+    {"exemplum", POS::NOUN, 'n' },
+    {"vita", POS::NOUN, 'f' },
+    {"casus", POS::NOUN, 'm' },
+    {"verbis", POS::NOUN, 'n' },
+    {"materia", POS::NOUN, 'f' },
+    {"legio", POS::NOUN, 'n' },
+    {"mare", POS::NOUN, 'n' },
+    {"proelium", POS::NOUN, 'n' },
+    {"sol", POS::NOUN, 'n' },
+    {"lingua", POS::NOUN, 'f' },
+    {"dignitas", POS::NOUN, 'n' },
+    {"puer", POS::NOUN, 'm' },
+    {"multitudo", POS::NOUN, 'n' },
+    {"munus", POS::NOUN, 'm' },
+    {"familia", POS::NOUN, 'f' },
+    {"condicio", POS::NOUN, 'n' },
+    {"studium", POS::NOUN, 'n' },
+    {"memoria", POS::NOUN, 'f' },
+    {"ira", POS::NOUN, 'f' },
+    {"lapis", POS::NOUN, 'n' },
+    {"periculum", POS::NOUN, 'n' },
+    {"auris", POS::NOUN, 'n' },
+    {"status", POS::NOUN, 'm' },
+    {"motus", POS::NOUN, 'm' },
+    {"parens", POS::NOUN, 'n' },
+    {"uiuo", POS::NOUN, 'n' },
+    {"auxilium", POS::NOUN, 'n' },
+    {"sacerdos", POS::NOUN, 'n' },
+    {"vitae", POS::NOUN, 'n' },
+    {"templum", POS::NOUN, 'n' },
+    {"Romani", POS::NOUN, 'n' },
+    {"ingenium", POS::NOUN, 'n' },
+    {"facies", POS::NOUN, 'n' },
+    {"pugna", POS::NOUN, 'f' },
+    {"dolor", POS::NOUN, 'm' },
+    {"iustitia", POS::NOUN, 'f' },
+    {"membrum", POS::NOUN, 'n' },
+    {"necessitas", POS::NOUN, 'n' },
+    {"aer", POS::NOUN, 'm' },
+    {"flumen", POS::NOUN, 'n' },
+    {"apostolus", POS::NOUN, 'm' },
+    {"copia", POS::NOUN, 'f' },
+    {"Israhel", POS::NOUN, 'n' },
+    {"praetor", POS::NOUN, 'm' },
+    {"aurum", POS::NOUN, 'n' },
+    {"regio", POS::NOUN, 'n' },
+    {"error", POS::NOUN, 'm' },
+    {"angelus", POS::NOUN, 'm' },
+    {"insula", POS::NOUN, 'f' },
+    {"armis", POS::NOUN, 'n' },
+    {"viri", POS::NOUN, 'n' },
+    {"iter", POS::NOUN, 'm' },
+    {"gradus", POS::NOUN, 'm' },
+    {"praesidium", POS::NOUN, 'n' },
+    {"beneficium", POS::NOUN, 'n' },
+    {"filia", POS::NOUN, 'f' },
+    {"vi", POS::NOUN, 'n' },
+    {"ferrum", POS::NOUN, 'n' },
+    {"metus", POS::NOUN, 'm' },
+    {"saeculum", POS::NOUN, 'n' },
+    {"timor", POS::NOUN, 'm' },
+    {"servus", POS::NOUN, 'm' },
+    {"color", POS::NOUN, 'm' },
+    {"initium", POS::NOUN, 'n' },
+    {"spatium", POS::NOUN, 'n' },
+    {"scriptura", POS::NOUN, 'f' },
+    {"fama", POS::NOUN, 'f' },
+    {"meritum", POS::NOUN, 'n' },
+    {"acies", POS::NOUN, 'n' },
+    {"creditor", POS::NOUN, 'm' },
+    {"dos", POS::NOUN, 'n' },
+    {"sacrificium", POS::NOUN, 'n' },
+    {"religio", POS::NOUN, 'n' },
+    {"actus", POS::NOUN, 'm' },
+    {"mensura", POS::NOUN, 'f' },
+    {"episcopus", POS::NOUN, 'm' },
+    {"vis", POS::NOUN, 'n' },
+    {"imago", POS::NOUN, 'n' },
+    {"forum", POS::NOUN, 'n' },
+    {"murus", POS::NOUN, 'm' },
+    {"iussus", POS::NOUN, 'm' },
+    {"viam", POS::NOUN, 'n' },
+    {"consule", POS::NOUN, 'n' },
+    {"propheta", POS::NOUN, 'f' },
+    {"origo", POS::NOUN, 'n' },
+    {"pietas", POS::NOUN, 'n' },
+    {"Domino", POS::NOUN, 'n' },
+    {"semen", POS::NOUN, 'n' },
+    {"vir", POS::NOUN, 'n' },
+    {"lignum", POS::NOUN, 'n' },
+    {"damnum", POS::NOUN, 'n' },
+    {"similitudo", POS::NOUN, 'n' },
+    {"soror", POS::NOUN, 'm' },
+    {"substantia", POS::NOUN, 'f' },
+    {"crimen", POS::NOUN, 'n' },
+    {"ora", POS::NOUN, 'f' },
+    {"femina", POS::NOUN, 'f' },
+    {"philosophus", POS::NOUN, 'm' },
+    {"militia", POS::NOUN, 'f' },
+    {"fatum", POS::NOUN, 'n' },
+    {"civitas", POS::NOUN, 'n' },
+    {"campus", POS::NOUN, 'm' },
+    {"praeda", POS::NOUN, 'f' },
+    {"intellectus", POS::NOUN, 'm' },
+    {"Caesar", POS::NOUN, 'n' },
+    {"culpa", POS::NOUN, 'f' },
+    {"animal", POS::NOUN, 'n' },
+    {"testis", POS::NOUN, 'n' },
+    {"tutor", POS::NOUN, 'm' },
+    {"creatura", POS::NOUN, 'f' },
+    {"via", POS::NOUN, 'f' },
+    {"gladius", POS::NOUN, 'm' },
+    {"Christi", POS::NOUN, 'n' },
+    {"capus", POS::NOUN, 'm' },
+    {"lumen", POS::NOUN, 'n' },
+    {"Romanis", POS::NOUN, 'n' },
+    {"magister", POS::NOUN, 'm' },
+    {"scelus", POS::NOUN, 'm' },
+    {"merces", POS::NOUN, 'n' },
+    {"laus", POS::NOUN, 'm' },
+    {"consuetudo", POS::NOUN, 'n' },
+    {"diabolus", POS::NOUN, 'm' },
+    {"facultas", POS::NOUN, 'n' },
+    {"sedes", POS::NOUN, 'n' },
+    {"emptor", POS::NOUN, 'm' },
+    {"doctrina", POS::NOUN, 'f' },
+    {"porta", POS::NOUN, 'f' },
+    {"mora", POS::NOUN, 'f' },
+    {"praefectus", POS::NOUN, 'm' },
+    {"cibus", POS::NOUN, 'm' },
+    {"praeceptum", POS::NOUN, 'n' },
+    {"verbum", POS::NOUN, 'n' },
+    {"socius", POS::NOUN, 'm' },
+    {"senatum", POS::NOUN, 'n' },
+    {"potentia", POS::NOUN, 'f' },
+    {"sors", POS::NOUN, 'n' },
+    {"fraus", POS::NOUN, 'm' },
+    {"puella", POS::NOUN, 'f' },
+    {"stella", POS::NOUN, 'f' },
+    {"opinio", POS::NOUN, 'n' },
+    {"Christo", POS::NOUN, 'n' },
+    {"misericordia", POS::NOUN, 'f' },
+    {"plebs", POS::NOUN, 'n' },
+    {"arbor", POS::NOUN, 'm' },
+    {"tribunus", POS::NOUN, 'm' },
+    {"procurator", POS::NOUN, 'm' },
+    {"turba", POS::NOUN, 'f' },
+    {"cursus", POS::NOUN, 'm' },
+    {"disciplina", POS::NOUN, 'f' },
+    {"exceptio", POS::NOUN, 'n' },
+    {"consulatus", POS::NOUN, 'm' },
+    {"Romam", POS::NOUN, 'n' },
+    {"profectus", POS::NOUN, 'm' },
+    {"hora", POS::NOUN, 'f' },
+    {"quaestio", POS::NOUN, 'n' },
+    {"fuga", POS::NOUN, 'f' },
+    {"magnitudo", POS::NOUN, 'n' },
+    {"arbitrium", POS::NOUN, 'n' },
+    {"Christus", POS::NOUN, 'm' },
+    {"dolus", POS::NOUN, 'm' },
+    {"effectus", POS::NOUN, 'm' },
+    {"hostis", POS::NOUN, 'n' },
+    {"ecclesia", POS::NOUN, 'f' },
+    {"caedes", POS::NOUN, 'n' },
+    {"epistula", POS::NOUN, 'f' },
+    {"quies", POS::NOUN, 'n' },
+    {"provinciae", POS::NOUN, 'n' },
+    {"Christum", POS::NOUN, 'n' },
+    {"tenebra", POS::NOUN, 'f' },
+    {"Caesaris", POS::NOUN, 'n' },
+    {"praetorium", POS::NOUN, 'n' },
+    {"testimonium", POS::NOUN, 'n' },
+    {"cognitio", POS::NOUN, 'n' },
+    {"voluntate", POS::NOUN, 'n' },
+    {"utilitas", POS::NOUN, 'n' },
+    {"Romae", POS::NOUN, 'n' },
+    {"stipulatio", POS::NOUN, 'n' },
+    {"odium", POS::NOUN, 'n' },
+    {"exitus", POS::NOUN, 'm' },
+    {"aedes", POS::NOUN, 'n' },
+    {"cultus", POS::NOUN, 'm' },
+    {"oleum", POS::NOUN, 'n' },
+    {"creator", POS::NOUN, 'm' },
+    {"debitor", POS::NOUN, 'm' },
+    {"praemium", POS::NOUN, 'n' },
+    {"orbis", POS::NOUN, 'n' },
+    {"cogitatio", POS::NOUN, 'n' },
+    {"philosophia", POS::NOUN, 'f' },
+    {"terminus", POS::NOUN, 'm' },
+    {"societas", POS::NOUN, 'n' },
+    {"servum", POS::NOUN, 'n' },
+    {"instrumentum", POS::NOUN, 'n' },
+    {"voce", POS::NOUN, 'n' },
+    {"circulus", POS::NOUN, 'm' },
+    {"natio", POS::NOUN, 'n' },
+    {"certamen", POS::NOUN, 'n' },
+    {"obsidio", POS::NOUN, 'n' },
+    {"mas", POS::NOUN, 'n' },
+    {"Hierusalem", POS::NOUN, 'n' },
+    {"Romano", POS::NOUN, 'n' },
+    {"legatio", POS::NOUN, 'n' },
+    {"umbra", POS::NOUN, 'f' },
+    {"viris", POS::NOUN, 'n' },
+    {"Italia", POS::NOUN, 'f' },
+    {"flamma", POS::NOUN, 'f' },
+    {"felicitas", POS::NOUN, 'n' },
+    {"pupillus", POS::NOUN, 'm' },
+    {"sacramentum", POS::NOUN, 'n' },
+    {"Romanos", POS::NOUN, 'n' },
+    {"possessor", POS::NOUN, 'm' },
+    {"obligatio", POS::NOUN, 'n' },
+    {"Romanorum", POS::NOUN, 'n' },
+    {"prudentia", POS::NOUN, 'f' },
+    {"mandatum", POS::NOUN, 'n' },
+    {"argumentum", POS::NOUN, 'n' },
+    {"prex", POS::NOUN, 'n' },
+    {"discrimen", POS::NOUN, 'n' },
+    {"testator", POS::NOUN, 'm' },
+    {"amnis", POS::NOUN, 'n' },
+    {"furtum", POS::NOUN, 'n' },
+    {"vim", POS::NOUN, 'n' },
+    {"vitam", POS::NOUN, 'n' },
+    {"matrimonium", POS::NOUN, 'n' },
+    {"Paulus", POS::NOUN, 'm' },
+    {"spons", POS::NOUN, 'n' },
+    {"momentum", POS::NOUN, 'n' },
+    {"virtute", POS::NOUN, 'n' },
+    {"curia", POS::NOUN, 'f' },
+    {"poeta", POS::NOUN, 'f' },
+    {"occasio", POS::NOUN, 'n' },
+    {"pontifex", POS::NOUN, 'n' },
+    {"urbes", POS::NOUN, 'n' },
+    {"circuitus", POS::NOUN, 'm' },
+    {"impetus", POS::NOUN, 'm' },
+    {"turbo", POS::NOUN, 'n' },
+    {"latro", POS::NOUN, 'n' },
+    {"licentia", POS::NOUN, 'f' },
+    {"aequor", POS::NOUN, 'm' },
+    {"principis", POS::NOUN, 'n' },
+    {"argentum", POS::NOUN, 'n' },
+    {"ciuitas", POS::NOUN, 'n' },
+    {"titulus", POS::NOUN, 'm' },
+    {"virorum", POS::NOUN, 'n' },
+    {"desiderium", POS::NOUN, 'n' },
+    {"ripa", POS::NOUN, 'f' },
+    {"pignus", POS::NOUN, 'm' },
+    {"nuptiae", POS::NOUN, 'n' },
+    {"tempestas", POS::NOUN, 'n' },
+    {"supplicium", POS::NOUN, 'n' },
+    {"donum", POS::NOUN, 'n' },
+    {"Italiam", POS::NOUN, 'n' },
+    {"terror", POS::NOUN, 'm' },
+    {"pondus", POS::NOUN, 'm' },
+    {"defensio", POS::NOUN, 'n' },
+    {"frumentum", POS::NOUN, 'n' },
+    {"orator", POS::NOUN, 'm' },
+    {"cornus", POS::NOUN, 'm' },
+    {"defensor", POS::NOUN, 'm' },
+    {"Iudas", POS::NOUN, 'n' },
+};
+
+constexpr StaticWord TEST_ADJECTIVES[] = {
+    {"hic", POS::ADJECTIVE, 'n' },
+    {"omnis", POS::ADJECTIVE, 'n' },
+    {"alius", POS::ADJECTIVE, 'm' },
+    {"multus", POS::ADJECTIVE, 'm' },
+    {"magnus", POS::ADJECTIVE, 'm' },
+    {"primus", POS::ADJECTIVE, 'm' },
+    {"totus", POS::ADJECTIVE, 'm' },
+    {"bonus", POS::ADJECTIVE, 'm' },
+    {"alter", POS::ADJECTIVE, 'm' },
+    {"summus", POS::ADJECTIVE, 'm' },
+    {"publicus", POS::ADJECTIVE, 'm' },
+    {"ceterus", POS::ADJECTIVE, 'm' },
+    {"solus", POS::ADJECTIVE, 'm' },
+    {"tantus", POS::ADJECTIVE, 'm' },
+    {"medius", POS::ADJECTIVE, 'm' },
+    {"talis", POS::ADJECTIVE, 'n' },
+    {"proprius", POS::ADJECTIVE, 'm' },
+    {"certus", POS::ADJECTIVE, 'm' },
+    {"singulus", POS::ADJECTIVE, 'm' },
+    {"princeps", POS::ADJECTIVE, 'n' },
+    {"similis", POS::ADJECTIVE, 'n' },
+    {"quantum", POS::ADJECTIVE, 'n' },
+    {"communis", POS::ADJECTIVE, 'n' },
+    {"ullus", POS::ADJECTIVE, 'm' },
+    {"humanus", POS::ADJECTIVE, 'm' },
+    {"reliquus", POS::ADJECTIVE, 'm' },
+    {"magne", POS::ADJECTIVE, 'n' },
+    {"secundus", POS::ADJECTIVE, 'm' },
+    {"iustus", POS::ADJECTIVE, 'm' },
+    {"patrius", POS::ADJECTIVE, 'm' },
+    {"malus", POS::ADJECTIVE, 'm' },
+    {"uerus", POS::ADJECTIVE, 'm' },
+    {"proximus", POS::ADJECTIVE, 'm' },
+    {"alienus", POS::ADJECTIVE, 'm' },
+    {"sacer", POS::ADJECTIVE, 'm' },
+    {"cunctus", POS::ADJECTIVE, 'm' },
+    {"superior", POS::ADJECTIVE, 'm' },
+    {"quantus", POS::ADJECTIVE, 'm' },
+    {"par", POS::ADJECTIVE, 'n' },
+    {"altus", POS::ADJECTIVE, 'm' },
+    {"prior", POS::ADJECTIVE, 'm' },
+    {"longus", POS::ADJECTIVE, 'm' },
+    {"paucus", POS::ADJECTIVE, 'm' },
+    {"prius", POS::ADJECTIVE, 'm' },
+    {"plerusque", POS::ADJECTIVE, 'n' },
+    {"necesse", POS::ADJECTIVE, 'n' },
+    {"aeternus", POS::ADJECTIVE, 'm' },
+    {"posterus", POS::ADJECTIVE, 'm' },
+    {"iniurius", POS::ADJECTIVE, 'm' },
+    {"ultimus", POS::ADJECTIVE, 'm' },
+    {"beatus", POS::ADJECTIVE, 'm' },
+    {"exterior", POS::ADJECTIVE, 'm' },
+    {"clarus", POS::ADJECTIVE, 'm' },
+    {"dexter", POS::ADJECTIVE, 'm' },
+    {"miser", POS::ADJECTIVE, 'm' },
+    {"plus", POS::ADJECTIVE, 'm' },
+    {"plenus", POS::ADJECTIVE, 'm' },
+    {"fortis", POS::ADJECTIVE, 'n' },
+    {"antiquus", POS::ADJECTIVE, 'm' },
+    {"nobilis", POS::ADJECTIVE, 'n' },
+    {"inferus", POS::ADJECTIVE, 'm' },
+    {"paulus", POS::ADJECTIVE, 'm' },
+    {"inimicus", POS::ADJECTIVE, 'm' },
+    {"necessarius", POS::ADJECTIVE, 'm' },
+    {"naturalis", POS::ADJECTIVE, 'n' },
+    {"mortalis", POS::ADJECTIVE, 'n' },
+    {"dignus", POS::ADJECTIVE, 'm' },
+    {"tanto", POS::ADJECTIVE, 'n' },
+    {"contrarius", POS::ADJECTIVE, 'm' },
+    {"perpetuus", POS::ADJECTIVE, 'm' },
+    {"integer", POS::ADJECTIVE, 'm' },
+    {"regius", POS::ADJECTIVE, 'm' },
+    {"incertus", POS::ADJECTIVE, 'm' },
+    {"amplus", POS::ADJECTIVE, 'm' },
+    {"nimius", POS::ADJECTIVE, 'm' },
+    {"pauper", POS::ADJECTIVE, 'm' },
+    {"aequus", POS::ADJECTIVE, 'm' },
+    {"ingens", POS::ADJECTIVE, 'n' },
+    {"dubius", POS::ADJECTIVE, 'm' },
+    {"modicus", POS::ADJECTIVE, 'm' },
+    {"facilis", POS::ADJECTIVE, 'n' },
+    {"iulianus", POS::ADJECTIVE, 'm' },
+    {"fidelis", POS::ADJECTIVE, 'n' },
+    {"honestus", POS::ADJECTIVE, 'm' },
+    {"utilis", POS::ADJECTIVE, 'n' },
+    {"vera", POS::ADJECTIVE, 'f' },
+    {"felix", POS::ADJECTIVE, 'n' },
+    {"caelestis", POS::ADJECTIVE, 'n' },
+    {"durus", POS::ADJECTIVE, 'm' },
+    {"continuus", POS::ADJECTIVE, 'm' },
+    {"mirus", POS::ADJECTIVE, 'm' },
+    {"quanto", POS::ADJECTIVE, 'n' },
+    {"penitus", POS::ADJECTIVE, 'm' },
+    {"vestra", POS::ADJECTIVE, 'f' },
+    {"manifestus", POS::ADJECTIVE, 'm' },
+    {"nonnullus", POS::ADJECTIVE, 'm' },
+    {"proprie", POS::ADJECTIVE, 'n' },
+    {"simplex", POS::ADJECTIVE, 'n' },
+    {"suburbanus", POS::ADJECTIVE, 'm' },
+    {"supplex", POS::ADJECTIVE, 'n' },
+    {"idoneus", POS::ADJECTIVE, 'm' },
+    {"divina", POS::ADJECTIVE, 'f' },
+    {"gratus", POS::ADJECTIVE, 'm' },
+    {"commodus", POS::ADJECTIVE, 'm' },
+    {"Romanus", POS::ADJECTIVE, 'm' },
+    {"duplex", POS::ADJECTIVE, 'n' },
+    {"paternus", POS::ADJECTIVE, 'm' },
+    {"turpis", POS::ADJECTIVE, 'n' },
+    {"difficilis", POS::ADJECTIVE, 'n' },
+    {"inanis", POS::ADJECTIVE, 'n' },
+    {"iniquus", POS::ADJECTIVE, 'm' },
+    {"sublimis", POS::ADJECTIVE, 'n' },
+    {"militaris", POS::ADJECTIVE, 'n' },
+    {"terrenus", POS::ADJECTIVE, 'm' },
+    {"universa", POS::ADJECTIVE, 'f' },
+};
+
+constexpr StaticWord TEST_VERBS[] = {
+    {"sum", POS::VERB, 'n' },
+    {"facio", POS::VERB, 'n' },
+    {"dico", POS::VERB, 'n' },
+    {"possum", POS::VERB, 'n' },
+    {"habeo", POS::VERB, 'n' },
+    {"do", POS::VERB, 'n' },
+    {"debeo", POS::VERB, 'n' },
+    {"ago", POS::VERB, 'n' },
+    {"accipio", POS::VERB, 'n' },
+    {"quaero", POS::VERB, 'n' },
+    {"scribo", POS::VERB, 'n' },
+    {"credo", POS::VERB, 'n' },
+    {"fero", POS::VERB, 'n' },
+    {"lego", POS::VERB, 'n' },
+    {"mitto", POS::VERB, 'n' },
+    {"scio", POS::VERB, 'n' },
+    {"audio", POS::VERB, 'n' },
+    {"intellego", POS::VERB, 'n' },
+    {"peto", POS::VERB, 'n' },
+    {"sequor", POS::VERB, 'n' },
+    {"puto", POS::VERB, 'n' },
+    {"aio", POS::VERB, 'n' },
+    {"inquam", POS::VERB, 'n' },
+    {"pono", POS::VERB, 'n' },
+    {"relinquo", POS::VERB, 'n' },
+    {"loquor", POS::VERB, 'n' },
+    {"licet", POS::VERB, 'n' },
+    {"morior", POS::VERB, 'n' },
+    {"reddo", POS::VERB, 'n' },
+    {"teneo", POS::VERB, 'n' },
+    {"gero", POS::VERB, 'n' },
+    {"cognosco", POS::VERB, 'n' },
+    {"respondeo", POS::VERB, 'n' },
+    {"utor", POS::VERB, 'n' },
+    {"soleo", POS::VERB, 'n' },
+    {"nascor", POS::VERB, 'n' },
+    {"duco", POS::VERB, 'n' },
+    {"recipio", POS::VERB, 'n' },
+    {"refero", POS::VERB, 'n' },
+    {"patior", POS::VERB, 'n' },
+    {"appello", POS::VERB, 'n' },
+    {"iudico", POS::VERB, 'n' },
+    {"oportet", POS::VERB, 'n' },
+    {"capio", POS::VERB, 'n' },
+    {"contineo", POS::VERB, 'n' },
+    {"trado", POS::VERB, 'n' },
+    {"suscipio", POS::VERB, 'n' },
+    {"occido", POS::VERB, 'n' },
+    {"nosco", POS::VERB, 'n' },
+    {"placeo", POS::VERB, 'n' },
+    {"constituo", POS::VERB, 'n' },
+    {"redeo", POS::VERB, 'n' },
+    {"cogo", POS::VERB, 'n' },
+    {"probo", POS::VERB, 'n' },
+    {"transeo", POS::VERB, 'n' },
+    {"iubeo", POS::VERB, 'n' },
+    {"eo", POS::VERB, 'n' },
+    {"coepio", POS::VERB, 'n' },
+    {"videtur", POS::VERB, 'n' },
+    {"paro", POS::VERB, 'n' },
+    {"promitto", POS::VERB, 'n' },
+    {"ostendo", POS::VERB, 'n' },
+    {"restituo", POS::VERB, 'n' },
+    {"maneo", POS::VERB, 'n' },
+    {"praedico", POS::VERB, 'n' },
+    {"sentio", POS::VERB, 'n' },
+    {"pertineo", POS::VERB, 'n' },
+    {"instituo", POS::VERB, 'n' },
+    {"infero", POS::VERB, 'n' },
+    {"propono", POS::VERB, 'n' },
+    {"praecipio", POS::VERB, 'n' },
+    {"defero", POS::VERB, 'n' },
+    {"doceo", POS::VERB, 'n' },
+    {"offero", POS::VERB, 'n' },
+    {"possideo", POS::VERB, 'n' },
+    {"praesum", POS::VERB, 'n' },
+    {"consto", POS::VERB, 'n' },
+    {"consulo", POS::VERB, 'n' },
+    {"nolo", POS::VERB, 'n' },
+    {"diligo", POS::VERB, 'n' },
+    {"muto", POS::VERB, 'n' },
+    {"confero", POS::VERB, 'n' },
+    {"amo", POS::VERB, 'n' },
+    {"prohibeo", POS::VERB, 'n' },
+    {"sto", POS::VERB, 'n' },
+    {"consequor", POS::VERB, 'n' },
+    {"efficio", POS::VERB, 'n' },
+    {"appareo", POS::VERB, 'n' },
+    {"sumo", POS::VERB, 'n' },
+    {"curo", POS::VERB, 'n' },
+    {"timeo", POS::VERB, 'n' },
+    {"nego", POS::VERB, 'n' },
+    {"libero", POS::VERB, 'n' },
+    {"mereo", POS::VERB, 'n' },
+    {"tollo", POS::VERB, 'n' },
+    {"absum", POS::VERB, 'n' },
+    {"occupo", POS::VERB, 'n' },
+    {"exsisto", POS::VERB, 'n' },
+    {"traho", POS::VERB, 'n' },
+    {"significo", POS::VERB, 'n' },
+    {"defendo", POS::VERB, 'n' },
+    {"nomino", POS::VERB, 'n' },
+    {"cogito", POS::VERB, 'n' },
+    {"audeo", POS::VERB, 'n' },
+    {"committo", POS::VERB, 'n' },
+    {"concedo", POS::VERB, 'n' },
+    {"ingredior", POS::VERB, 'n' },
+    {"pereo", POS::VERB, 'n' },
+    {"desum", POS::VERB, 'n' },
+    {"adsum", POS::VERB, 'n' },
+    {"addo", POS::VERB, 'n' },
+    {"oro", POS::VERB, 'n' },
+    {"dubito", POS::VERB, 'n' },
+    {"intersum", POS::VERB, 'n' },
+    {"accido", POS::VERB, 'n' },
+    {"eligo", POS::VERB, 'n' },
+    {"colo", POS::VERB, 'n' },
+    {"depono", POS::VERB, 'n' },
+    {"procedo", POS::VERB, 'n' },
+    {"venit", POS::VERB, 'n' },
+    {"permitto", POS::VERB, 'n' },
+    {"spero", POS::VERB, 'n' },
+    {"egredior", POS::VERB, 'n' },
+    {"sustineo", POS::VERB, 'n' },
+    {"accedo", POS::VERB, 'n' },
+    {"retineo", POS::VERB, 'n' },
+    {"deduco", POS::VERB, 'n' },
+    {"misceo", POS::VERB, 'n' },
+    {"ignoro", POS::VERB, 'n' },
+    {"amitto", POS::VERB, 'n' },
+    {"existimo", POS::VERB, 'n' },
+    {"dono", POS::VERB, 'n' },
+    {"irascor", POS::VERB, 'n' },
+    {"esse", POS::VERB, 'n' },
+    {"praebeo", POS::VERB, 'n' },
+    {"nescio", POS::VERB, 'n' },
+    {"potior", POS::VERB, 'n' },
+    {"cado", POS::VERB, 'n' },
+    {"competo", POS::VERB, 'n' },
+    {"fugio", POS::VERB, 'n' },
+    {"rogo", POS::VERB, 'n' },
+    {"persequor", POS::VERB, 'n' },
+    {"dimitto", POS::VERB, 'n' },
+    {"subeo", POS::VERB, 'n' },
+    {"postulo", POS::VERB, 'n' },
+    {"statuo", POS::VERB, 'n' },
+    {"tribuo", POS::VERB, 'n' },
+    {"impleo", POS::VERB, 'n' },
+    {"aperio", POS::VERB, 'n' },
+    {"defungor", POS::VERB, 'n' },
+    {"contingo", POS::VERB, 'n' },
+    {"exigo", POS::VERB, 'n' },
+    {"sedeo", POS::VERB, 'n' },
+    {"condo", POS::VERB, 'n' },
+    {"laudo", POS::VERB, 'n' },
+    {"excipio", POS::VERB, 'n' },
+    {"nuntio", POS::VERB, 'n' },
+    {"disco", POS::VERB, 'n' },
+    {"gigno", POS::VERB, 'n' },
+    {"rego", POS::VERB, 'n' },
+    {"specto", POS::VERB, 'n' },
+    {"confiteor", POS::VERB, 'n' },
+    {"abeo", POS::VERB, 'n' },
+    {"pugno", POS::VERB, 'n' },
+    {"taceo", POS::VERB, 'n' },
+    {"affero", POS::VERB, 'n' },
+    {"consisto", POS::VERB, 'n' },
+    {"censeo", POS::VERB, 'n' },
+    {"uoco", POS::VERB, 'n' },
+    {"magistro", POS::VERB, 'n' },
+    {"cedo", POS::VERB, 'n' },
+    {"profero", POS::VERB, 'n' },
+    {"descendo", POS::VERB, 'n' },
+    {"ascendo", POS::VERB, 'n' },
+    {"edo", POS::VERB, 'n' },
+    {"instruo", POS::VERB, 'n' },
+    {"obligo", POS::VERB, 'n' },
+    {"impero", POS::VERB, 'n' },
+    {"dispono", POS::VERB, 'n' },
+    {"delinquo", POS::VERB, 'n' },
+    {"praetereo", POS::VERB, 'n' },
+    {"intro", POS::VERB, 'n' },
+    {"decedo", POS::VERB, 'n' },
+    {"obtineo", POS::VERB, 'n' },
+    {"numero", POS::VERB, 'n' },
+    {"repeto", POS::VERB, 'n' },
+    {"percipio", POS::VERB, 'n' },
+    {"mando", POS::VERB, 'n' },
+    {"contraho", POS::VERB, 'n' },
+    {"loco", POS::VERB, 'n' },
+    {"supero", POS::VERB, 'n' },
+    {"corrumpo", POS::VERB, 'n' },
+    {"furor", POS::VERB, 'n' },
+    {"coniungo", POS::VERB, 'n' },
+    {"admitto", POS::VERB, 'n' },
+    {"tempto", POS::VERB, 'n' },
+    {"aufero", POS::VERB, 'n' },
+    {"exspecto", POS::VERB, 'n' },
+    {"praefero", POS::VERB, 'n' },
+    {"damno", POS::VERB, 'n' },
+    {"resisto", POS::VERB, 'n' },
+    {"pateo", POS::VERB, 'n' },
+    {"creo", POS::VERB, 'n' },
+    {"discedo", POS::VERB, 'n' },
+    {"exhibeo", POS::VERB, 'n' },
+    {"regno", POS::VERB, 'n' },
+    {"concipio", POS::VERB, 'n' },
+    {"videri", POS::VERB, 'n' },
+    {"cupio", POS::VERB, 'n' },
+    {"arbitror", POS::VERB, 'n' },
+    {"desidero", POS::VERB, 'n' },
+    {"iungo", POS::VERB, 'n' },
+    {"deficio", POS::VERB, 'n' },
+    {"convenit", POS::VERB, 'n' },
+    {"definio", POS::VERB, 'n' },
+    {"cesso", POS::VERB, 'n' },
+    {"aestimo", POS::VERB, 'n' },
+    {"perdo", POS::VERB, 'n' },
+    {"fundo", POS::VERB, 'n' },
+    {"comparo", POS::VERB, 'n' },
+    {"remitto", POS::VERB, 'n' },
+    {"adhibeo", POS::VERB, 'n' },
+    {"dirigo", POS::VERB, 'n' },
+    {"expedio", POS::VERB, 'n' },
+    {"oppono", POS::VERB, 'n' },
+    {"interrogo", POS::VERB, 'n' },
+    {"pario", POS::VERB, 'n' },
+    {"conficio", POS::VERB, 'n' },
+    {"adicio", POS::VERB, 'n' },
+    {"transfero", POS::VERB, 'n' },
+    {"tracto", POS::VERB, 'n' },
+    {"cito", POS::VERB, 'n' },
+    {"incipio", POS::VERB, 'n' },
+    {"demonstro", POS::VERB, 'n' },
+    {"opprimo", POS::VERB, 'n' },
+    {"nitor", POS::VERB, 'n' },
+    {"differo", POS::VERB, 'n' },
+    {"compono", POS::VERB, 'n' },
+    {"impono", POS::VERB, 'n' },
+    {"custodio", POS::VERB, 'n' },
+    {"sufficio", POS::VERB, 'n' },
+    {"exeo", POS::VERB, 'n' },
+    {"finio", POS::VERB, 'n' },
+    {"lateo", POS::VERB, 'n' },
+    {"emo", POS::VERB, 'n' },
+    {"noceo", POS::VERB, 'n' },
+    {"habito", POS::VERB, 'n' },
+    {"rescribo", POS::VERB, 'n' },
+    {"decerno", POS::VERB, 'n' },
+    {"pronuntio", POS::VERB, 'n' },
+    {"considero", POS::VERB, 'n' },
+    {"destino", POS::VERB, 'n' },
+    {"confirmo", POS::VERB, 'n' },
+    {"proficiscor", POS::VERB, 'n' },
+    {"occurro", POS::VERB, 'n' },
+    {"intendo", POS::VERB, 'n' },
+    {"miror", POS::VERB, 'n' },
+    {"venire", POS::VERB, 'n' },
+    {"iaceo", POS::VERB, 'n' },
+    {"tego", POS::VERB, 'n' },
+    {"adduco", POS::VERB, 'n' },
+    {"contendo", POS::VERB, 'n' },
+    {"tango", POS::VERB, 'n' },
+    {"congrego", POS::VERB, 'n' },
+    {"impedio", POS::VERB, 'n' },
+    {"pecco", POS::VERB, 'n' },
+    {"armo", POS::VERB, 'n' },
+    {"induco", POS::VERB, 'n' },
+    {"insum", POS::VERB, 'n' },
+    {"careo", POS::VERB, 'n' },
+    {"como", POS::VERB, 'n' },
+    {"desero", POS::VERB, 'n' },
+    {"excito", POS::VERB, 'n' },
+    {"expugno", POS::VERB, 'n' },
+    {"impetro", POS::VERB, 'n' },
+    {"iuro", POS::VERB, 'n' },
+    {"adquiro", POS::VERB, 'n' },
+    {"accuso", POS::VERB, 'n' },
+    {"occulo", POS::VERB, 'n' },
+    {"laboro", POS::VERB, 'n' },
+    {"edico", POS::VERB, 'n' },
+    {"effundo", POS::VERB, 'n' },
+    {"pendeo", POS::VERB, 'n' },
+    {"expono", POS::VERB, 'n' },
+    {"voluit", POS::VERB, 'n' },
+    {"remaneo", POS::VERB, 'n' },
+    {"orior", POS::VERB, 'n' },
+    {"interdico", POS::VERB, 'n' },
+    {"perduco", POS::VERB, 'n' },
+    {"monstro", POS::VERB, 'n' },
+    {"erro", POS::VERB, 'n' },
+    {"colligo", POS::VERB, 'n' },
+    {"prodeo", POS::VERB, 'n' },
+    {"tempero", POS::VERB, 'n' },
+    {"moneo", POS::VERB, 'n' },
+    {"pector", POS::VERB, 'n' },
+    {"decet", POS::VERB, 'n' },
+    {"neglego", POS::VERB, 'n' },
+    {"incido", POS::VERB, 'n' },
+    {"adoro", POS::VERB, 'n' },
+    {"testor", POS::VERB, 'n' },
+    {"auro", POS::VERB, 'n' },
+    {"reperio", POS::VERB, 'n' },
+    {"indico", POS::VERB, 'n' },
+    {"extendo", POS::VERB, 'n' },
+    {"fallo", POS::VERB, 'n' },
+    {"requiro", POS::VERB, 'n' },
+    {"succedo", POS::VERB, 'n' },
+    {"videntur", POS::VERB, 'n' },
+    {"emitto", POS::VERB, 'n' },
+    {"commendo", POS::VERB, 'n' },
+    {"experior", POS::VERB, 'n' },
+    {"paco", POS::VERB, 'n' },
+    {"celebro", POS::VERB, 'n' },
+    {"memoro", POS::VERB, 'n' },
+    {"tergo", POS::VERB, 'n' },
+    {"interficio", POS::VERB, 'n' },
+    {"quiesco", POS::VERB, 'n' },
+    {"praeparo", POS::VERB, 'n' },
+    {"videatur", POS::VERB, 'n' },
+    {"sino", POS::VERB, 'n' },
+    {"exerceo", POS::VERB, 'n' },
+    {"comedo", POS::VERB, 'n' },
+    {"excello", POS::VERB, 'n' },
+    {"comprehendo", POS::VERB, 'n' },
+    {"praepono", POS::VERB, 'n' },
+    {"impendo", POS::VERB, 'n' },
+    {"desino", POS::VERB, 'n' },
+    {"prosum", POS::VERB, 'n' },
+    {"consumo", POS::VERB, 'n' },
+    {"subicio", POS::VERB, 'n' },
+    {"munio", POS::VERB, 'n' },
+    {"rapio", POS::VERB, 'n' },
+    {"oppugno", POS::VERB, 'n' },
+    {"gaudeo", POS::VERB, 'n' },
+    {"subdo", POS::VERB, 'n' },
+    {"opinor", POS::VERB, 'n' },
+    {"respicio", POS::VERB, 'n' },
+    {"adiungo", POS::VERB, 'n' },
+    {"condemno", POS::VERB, 'n' },
+    {"inclino", POS::VERB, 'n' },
+    {"parco", POS::VERB, 'n' },
+    {"ordino", POS::VERB, 'n' },
+    {"patro", POS::VERB, 'n' },
+    {"punio", POS::VERB, 'n' },
+    {"animo", POS::VERB, 'n' },
+    {"clamo", POS::VERB, 'n' },
+    {"praemitto", POS::VERB, 'n' },
+    {"excedo", POS::VERB, 'n' },
+    {"separo", POS::VERB, 'n' },
+    {"vult", POS::VERB, 'n' },
+    {"memini", POS::VERB, 'n' },
+    {"declino", POS::VERB, 'n' },
+    {"distinguo", POS::VERB, 'n' },
+    {"minuo", POS::VERB, 'n' },
+    {"sapio", POS::VERB, 'n' },
+    {"reficio", POS::VERB, 'n' },
+    {"agnosco", POS::VERB, 'n' },
+    {"cerno", POS::VERB, 'n' },
+    {"recedo", POS::VERB, 'n' },
+    {"educo", POS::VERB, 'n' },
+};
+
+constexpr StaticWord TEST_ADVERBS[] = {
+    {"etiam", POS::ADVERB, 'n' },
+    {"ita", POS::ADVERB, 'n' },
+    {"iam", POS::ADVERB, 'n' },
+    {"quoque", POS::ADVERB, 'n' },
+    {"quidem", POS::ADVERB, 'n' },
+    {"vero", POS::ADVERB, 'n' },
+    {"nunc", POS::ADVERB, 'n' },
+    {"sic", POS::ADVERB, 'n' },
+    {"ubi", POS::ADVERB, 'n' },
+    {"tam", POS::ADVERB, 'n' },
+    {"ergo", POS::ADVERB, 'n' },
+    {"tantum", POS::ADVERB, 'n' },
+    {"tum", POS::ADVERB, 'n' },
+    {"magis", POS::ADVERB, 'n' },
+    {"minus", POS::ADVERB, 'n' },
+    {"usque", POS::ADVERB, 'n' },
+    {"solum", POS::ADVERB, 'n' },
+    {"semper", POS::ADVERB, 'n' },
+    {"praesto", POS::ADVERB, 'n' },
+    {"satis", POS::ADVERB, 'n' },
+    {"deinde", POS::ADVERB, 'n' },
+    {"inde", POS::ADVERB, 'n' },
+    {"ideo", POS::ADVERB, 'n' },
+    {"tunc", POS::ADVERB, 'n' },
+    {"unde", POS::ADVERB, 'n' },
+    {"adhuc", POS::ADVERB, 'n' },
+    {"postea", POS::ADVERB, 'n' },
+    {"ibi", POS::ADVERB, 'n' },
+    {"simul", POS::ADVERB, 'n' },
+    {"itaque", POS::ADVERB, 'n' },
+    {"bene", POS::ADVERB, 'n' },
+    {"numquam", POS::ADVERB, 'n' },
+    {"tamquam", POS::ADVERB, 'n' },
+    {"potius", POS::ADVERB, 'n' },
+    {"adeo", POS::ADVERB, 'n' },
+    {"scilicet", POS::ADVERB, 'n' },
+    {"hinc", POS::ADVERB, 'n' },
+    {"utique", POS::ADVERB, 'n' },
+    {"statim", POS::ADVERB, 'n' },
+    {"cur", POS::ADVERB, 'n' },
+    {"item", POS::ADVERB, 'n' },
+    {"multo", POS::ADVERB, 'n' },
+    {"iusum", POS::ADVERB, 'n' },
+    {"omnino", POS::ADVERB, 'n' },
+    {"certe", POS::ADVERB, 'n' },
+    {"verum", POS::ADVERB, 'n' },
+    {"saepe", POS::ADVERB, 'n' },
+    {"longe", POS::ADVERB, 'n' },
+    {"haud", POS::ADVERB, 'n' },
+    {"mox", POS::ADVERB, 'n' },
+    {"diu", POS::ADVERB, 'n' },
+    {"rursus", POS::ADVERB, 'n' },
+    {"tandem", POS::ADVERB, 'n' },
+    {"fere", POS::ADVERB, 'n' },
+    {"quamvis", POS::ADVERB, 'n' },
+    {"ample", POS::ADVERB, 'n' },
+    {"recte", POS::ADVERB, 'n' },
+    {"interim", POS::ADVERB, 'n' },
+    {"multum", POS::ADVERB, 'n' },
+    {"umquam", POS::ADVERB, 'n' },
+    {"iterum", POS::ADVERB, 'n' },
+    {"aliquando", POS::ADVERB, 'n' },
+    {"denique", POS::ADVERB, 'n' },
+    {"nondum", POS::ADVERB, 'n' },
+    {"parum", POS::ADVERB, 'n' },
+    {"huiusmodi", POS::ADVERB, 'n' },
+    {"velut", POS::ADVERB, 'n' },
+    {"quin", POS::ADVERB, 'n' },
+    {"quemadmodum", POS::ADVERB, 'n' },
+    {"male", POS::ADVERB, 'n' },
+    {"pariter", POS::ADVERB, 'n' },
+    {"facile", POS::ADVERB, 'n' },
+    {"quomodo", POS::ADVERB, 'n' },
+    {"aliter", POS::ADVERB, 'n' },
+    {"veluti", POS::ADVERB, 'n' },
+    {"diligenter", POS::ADVERB, 'n' },
+    {"coram", POS::ADVERB, 'n' },
+    {"videlicet", POS::ADVERB, 'n' },
+    {"hodie", POS::ADVERB, 'n' },
+    {"cumque", POS::ADVERB, 'n' },
+    {"quotiens", POS::ADVERB, 'n' },
+    {"saepius", POS::ADVERB, 'n' },
+    {"profecto", POS::ADVERB, 'n' },
+    {"vix", POS::ADVERB, 'n' },
+    {"primo", POS::ADVERB, 'n' },
+    {"tantummodo", POS::ADVERB, 'n' },
+    {"procul", POS::ADVERB, 'n' },
+    {"vere", POS::ADVERB, 'n' },
+    {"praeterea", POS::ADVERB, 'n' },
+    {"sane", POS::ADVERB, 'n' },
+    {"immo", POS::ADVERB, 'n' },
+    {"quare", POS::ADVERB, 'n' },
+    {"nonne", POS::ADVERB, 'n' },
+    {"olim", POS::ADVERB, 'n' },
+    {"porro", POS::ADVERB, 'n' },
+    {"valde", POS::ADVERB, 'n' },
+    {"semel", POS::ADVERB, 'n' },
+    {"protinus", POS::ADVERB, 'n' },
+    {"nimis", POS::ADVERB, 'n' },
+    {"ultro", POS::ADVERB, 'n' },
+    {"plane", POS::ADVERB, 'n' },
+    {"prae", POS::ADVERB, 'n' },
+};
+
+constexpr StaticWord TEST_CONJUNCTIONS[] = {
+    {"et", POS::CONJUNCTION, 'n' },
+    {"ut", POS::CONJUNCTION, 'n' },
+    {"si", POS::CONJUNCTION, 'n' },
+    {"sed", POS::CONJUNCTION, 'n' },
+    {"atque", POS::CONJUNCTION, 'n' },
+    {"quod", POS::CONJUNCTION, 'n' },
+    {"enim", POS::CONJUNCTION, 'n' },
+    {"aut", POS::CONJUNCTION, 'n' },
+    {"autem", POS::CONJUNCTION, 'n' },
+    {"nec", POS::CONJUNCTION, 'n' },
+    {"quam", POS::CONJUNCTION, 'n' },
+    {"vel", POS::CONJUNCTION, 'n' },
+    {"quia", POS::CONJUNCTION, 'n' },
+    {"tamen", POS::CONJUNCTION, 'n' },
+    {"ne", POS::CONJUNCTION, 'n' },
+    {"neque", POS::CONJUNCTION, 'n' },
+    {"nisi", POS::CONJUNCTION, 'n' },
+    {"sicut", POS::CONJUNCTION, 'n' },
+    {"nam", POS::CONJUNCTION, 'n' },
+    {"igitur", POS::CONJUNCTION, 'n' },
+    {"an", POS::CONJUNCTION, 'n' },
+    {"quasi", POS::CONJUNCTION, 'n' },
+    {"sive", POS::CONJUNCTION, 'n' },
+    {"dum", POS::CONJUNCTION, 'n' },
+    {"quoniam", POS::CONJUNCTION, 'n' },
+    {"quando", POS::CONJUNCTION, 'n' },
+    {"siue", POS::CONJUNCTION, 'n' },
+    {"at", POS::CONJUNCTION, 'n' },
+    {"utrum", POS::CONJUNCTION, 'n' },
+    {"postquam", POS::CONJUNCTION, 'n' },
+    {"donec", POS::CONJUNCTION, 'n' },
+    {"etsi", POS::CONJUNCTION, 'n' },
+    {"quamquam", POS::CONJUNCTION, 'n' },
+    {"antequam", POS::CONJUNCTION, 'n' },
+    {"priusquam", POS::CONJUNCTION, 'n' },
+};
+
+constexpr StaticWord TEST_PREPOSITIONS[] = {
+    {"in", POS::PREPOSITION, 'n' },
+    {"ad", POS::PREPOSITION, 'n' },
+    {"ab", POS::PREPOSITION, 'n' },
+    {"cum", POS::PREPOSITION, 'n' },
+    {"de", POS::PREPOSITION, 'n' },
+    {"ex", POS::PREPOSITION, 'n' },
+    {"per", POS::PREPOSITION, 'n' },
+    {"pro", POS::PREPOSITION, 'n' },
+    {"inter", POS::PREPOSITION, 'n' },
+    {"sine", POS::PREPOSITION, 'n' },
+    {"ante", POS::PREPOSITION, 'n' },
+    {"post", POS::PREPOSITION, 'n' },
+    {"apud", POS::PREPOSITION, 'n' },
+    {"super", POS::PREPOSITION, 'n' },
+    {"contra", POS::PREPOSITION, 'n' },
+    {"propter", POS::PREPOSITION, 'n' },
+    {"sub", POS::PREPOSITION, 'n' },
+    {"secundum", POS::PREPOSITION, 'n' },
+    {"ob", POS::PREPOSITION, 'n' },
+    {"adversus", POS::PREPOSITION, 'n' },
+    {"supra", POS::PREPOSITION, 'n' },
+    {"circa", POS::PREPOSITION, 'n' },
+    {"intra", POS::PREPOSITION, 'n' },
+    {"praeter", POS::PREPOSITION, 'n' },
+    {"ultra", POS::PREPOSITION, 'n' },
+    {"prope", POS::PREPOSITION, 'n' },
+    {"extra", POS::PREPOSITION, 'n' },
+    {"iuxta", POS::PREPOSITION, 'n' },
+    {"penes", POS::PREPOSITION, 'n' },
+};
+
+/**
+ * The words of one part of speech regrouped by gender. Genders are ordered by first
+ * appearance and words keep their relative order, like IndexedDictionary's gender runs.
+ */
+template <size_t N>
+struct GroupedWords {
+    std::string_view words[N];
+    float            weights[N];
+    char             genders[N];
+    size_t           run_begin[N];
+    size_t           run_count[N];
+    size_t           runs;
+};
+
+template <size_t N>
+constexpr GroupedWords<N> group_by_gender(const StaticWord (&list)[N]) {
+    GroupedWords<N> out{};
+    size_t filled = 0;
+    for (size_t i = 0; i < N; i++) {
+        bool seen = false;
+        for (size_t r = 0; r < out.runs; r++) {
+            if (out.genders[r] == list[i].gender)
+                seen = true;
+        }
+        if (seen)
+            continue;
+
+        out.genders[out.runs] = list[i].gender;
+        out.run_begin[out.runs] = filled;
+        for (size_t j = i; j < N; j++) {
+            if (list[j].gender == list[i].gender) {
+                out.words[filled] = list[j].text;
+                out.weights[filled++] = rank_weight(list[j], j);
+            }
+        }
+        out.run_count[out.runs] = filled - out.run_begin[out.runs];
+        out.runs++;
+    }
+    return out;
 }
 
-Dictionary get_test_dictionary() {
-    Dictionary dict;
+template <size_t N>
+constexpr std::array<GenderSpan, N> gender_spans(const GroupedWords<N>& grouped) {
+    std::array<GenderSpan, N> spans{};
+    for (size_t r = 0; r < grouped.runs; r++) {
+        spans[r] = { grouped.genders[r], grouped.words + grouped.run_begin[r], grouped.run_count[r],
+                     grouped.weights + grouped.run_begin[r] };
+    }
+    return spans;
+}
+
+/* Compile-time WordTable entry for one of the word lists above */
+template <const auto& List>
+struct StaticPart {
+    static constexpr auto grouped = group_by_gender(List);
+    static constexpr auto spans = gender_spans(grouped);
+
+    static constexpr PosWords part() {
+        return { grouped.words, std::size(List), spans.data(), grouped.runs, grouped.weights };
+    }
+};
+
+template <size_t N>
+constexpr size_t longest_word(const StaticWord (&list)[N]) {
+    size_t longest = 0;
+    for (const StaticWord& word : list) {
+        longest = std::max(longest, word.text.size());
+    }
+    return longest;
+}
+
+/* Length of the longest word in any of @p Lists */
+template <const auto&... Lists>
+constexpr size_t longest_word() {
+    return std::max({ longest_word(Lists)... });
+}
 
-    dict[POS::NOUN] = {
-        {"res", POS::NOUN, 'n' },
-        {"homo", POS::NOUN, 'n' },
-        {"pars", POS::NOUN, 'n' },
-        {"causa", POS::NOUN, 'f' },
-        {"tempus", POS::NOUN, 'm' },
-        {"nomen", POS::NOUN, 'n' },
-        {"filius", POS::NOUN, 'm' },
-        {"dies", POS::NOUN, 'n' },
-        {"locus", POS::NOUN, 'm' },
-        {"modus", POS::NOUN, 'm' },
-        {"rex", POS::NOUN, 'n' },
-        {"deus", POS::NOUN, 'm' },
-        {"terra", POS::NOUN, 'f' },
-        {"pater", POS::NOUN, 'm' },
-        {"corpus", POS::NOUN, 'm' },
-        {"opus", POS::NOUN, 'm' },
-        {"populus", POS::NOUN, 'm' },
-        {"liber", POS::NOUN, 'm' },
-        {"bonum", POS::NOUN, 'n' },
-        {"genus", POS::NOUN, 'm' },
-        {"animus", POS::NOUN, 'm' },
-        {"dominus", POS::NOUN, 'm' },
-        {"bellum", POS::NOUN, 'n' },
-        {"lex", POS::NOUN, 'n' },
-        {"ius", POS::NOUN, 'm' },
-        {"ratio", POS::NOUN, 'n' },
-        {"fides", POS::NOUN, 'n' },
-        {"manus", POS::NOUN, 'm' },
-        {"annus", POS::NOUN, 'm' },
-        {"exercitus", POS::NOUN, 'm' },
-        {"natura", POS::NOUN, 'f' },
-        {"domus", POS::NOUN, 'm' },
-        {"actio", POS::NOUN, 'n' },
-        {"mors", POS::NOUN, 'n' },
-        {"malum", POS::NOUN, 'n' },
-        {"miles", POS::NOUN, 'n' },
-        {"gens", POS::NOUN, 'n' },
-        {"castra", POS::NOUN, 'f' },
-        {"Deus", POS::NOUN, 'm' },
-        {"iudicium", POS::NOUN, 'n' },
-        {"mens", POS::NOUN, 'n' },
-        {"frater", POS::NOUN, 'm' },
-        {"dux", POS::NOUN, 'n' },
-        {"pecunia", POS::NOUN, 'f' },
-        {"consilium", POS::NOUN, 'n' },
-        {"ordo", POS::NOUN, 'n' },
-        {"caelum", POS::NOUN, 'n' },
-        {"iudex", POS::NOUN, 'n' },
-        {"cor", POS::NOUN, 'm' },
-        {"mater", POS::NOUN, 'm' },
-        {"mos", POS::NOUN, 'n' },
-        {"regnum", POS::NOUN, 'n' },
-        {"sententia", POS::NOUN, 'f' },
-        {"gratia", POS::NOUN, 'f' },
-        {"usus", POS::NOUN, 'm' },
-        {"finis", POS::NOUN, 'n' },
-        {"heres", POS::NOUN, 'n' },
-        {"anima", POS::NOUN, 'f' },
-        {"officium", POS::NOUN, 'n' },
-        {"potestas", POS::NOUN, 'n' },
-        {"ager", POS::NOUN, 'm' },
-        {"oculus", POS::NOUN, 'm' },
-        {"urbs", POS::NOUN, 'n' },
-        {"labor", POS::NOUN, 'm' },
-        {"persona", POS::NOUN, 'f' },
-        {"Dominus", POS::NOUN, 'm' },
-        {"aqua", POS::NOUN, 'f' },
-        {"littera", POS::NOUN, 'f' },
-        {"caro", POS::NOUN, 'n' },
-        {"ignis", POS::NOUN, 'n' },
-        {"Deo", POS::NOUN, 'n' },
-        {"principium", POS::NOUN, 'n' },
-        {"uxor", POS::NOUN, 'm' },
-        {"urbis", POS::NOUN, 'n' },
-        {"species", POS::NOUN, 'n' },
-        {"honor", POS::NOUN, 'm' },
-        {"pax", POS::NOUN, 'n' },
-        {"amicus", POS::NOUN, 'm' },
-        {"hereditas", POS::NOUN, 'n' },
-        {"spiritus", POS::NOUN, 'm' },
-        {"legatum", POS::NOUN, 'n' },
-        {"ars", POS::NOUN, 'n' },
-        {"libertas", POS::NOUN, 'n' },
-        {"fructus", POS::NOUN, 'm' },
-        {"aetas", POS::NOUN, 'n' },
-        {"possessio", POS::NOUN, 'n' },
-        {"mulier", POS::NOUN, 'm' },
-        {"sanguis", POS::NOUN, 'n' },
-        {"pes", POS::NOUN, 'n' },
-        {"nox", POS::NOUN, 'n' },
-        {"lux", POS::NOUN, 'n' },
-        {"senatus", POS::NOUN, 'm' },
-        {"signum", POS::NOUN, 'n' },
-        {"spes", POS::NOUN, 'n' },
-        {"os", POS::NOUN, 'n' },
-        {"peccatum", POS::NOUN, 'n' },
-        {"imperator", POS::NOUN, 'm' },
-        {"auctor", POS::NOUN, 'm' },
-        {"mons", POS::NOUN, 'n' },
-        {"testamentum", POS::NOUN, 'n' },
-        {"sermo", POS::NOUN, 'n' },
-        {"imperium", POS::NOUN, 'n' },
-        {"numerus", POS::NOUN, 'm' },
-        {"sensus", POS::NOUN, 'm' },
-        {"Domini", POS::NOUN, 'n' },
-        {"forma", POS::NOUN, 'f' },
-        {"oratio", POS::NOUN, 'n' },
-        {"fortuna", POS::NOUN, 'f' },
-        {"arma", POS::NOUN, 'f' },
-        {"gloria", POS::NOUN, 'f' },
-        {"poena", POS::NOUN, 'f' },
-        {"sapientia", POS::NOUN, 'f' },
-        {"fundus", POS::NOUN, 'm' },
-        {"forte", POS::NOUN, 'n' },
-        {"cura", POS::NOUN, 'f' },
-        {"scientia", POS::NOUN, 'f' },
-        {"salus", POS::NOUN, 'm' },
-        {"Deum", POS::NOUN, 'n' },
-        {"mundus", POS::NOUN, 'm' },
-        {"consul", POS::NOUN, 'n' },
-        {"equus", POS::NOUN, 'm' },
-        {"pretium", POS::NOUN, 'n' },
-        {"caput", POS::NOUN, 'n' },
-        {"amor", POS::NOUN, 'm' },
-        {"auctoritas", POS::NOUN, 'n' },
-        {"exemplum", POS::NOUN, 'n' },
-        {"vita", POS::NOUN, 'f' },
-        {"casus", POS::NOUN, 'm' },
-        {"verbis", POS::NOUN, 'n' },
-        {"materia", POS::NOUN, 'f' },
-        {"legio", POS::NOUN, 'n' },
-        {"mare", POS::NOUN, 'n' },
-        {"proelium", POS::NOUN, 'n' },
-        {"sol", POS::NOUN, 'n' },
-        {"lingua", POS::NOUN, 'f' },
-        {"dignitas", POS::NOUN, 'n' },
-        {"puer", POS::NOUN, 'm' },
-        {"multitudo", POS::NOUN, 'n' },
-        {"munus", POS::NOUN, 'm' },
-        {"familia", POS::NOUN, 'f' },
-        {"condicio", POS::NOUN, 'n' },
-        {"studium", POS::NOUN, 'n' },
-        {"memoria", POS::NOUN, 'f' },
-        {"ira", POS::NOUN, 'f' },
-        {"lapis", POS::NOUN, 'n' },
-        {"periculum", POS::NOUN, 'n' },
-        {"auris", POS::NOUN, 'n' },
-        {"status", POS::NOUN, 'm' },
-        {"motus", POS::NOUN, 'm' },
-        {"parens", POS::NOUN, 'n' },
-        {"uiuo", POS::NOUN, 'n' },
-        {"auxilium", POS::NOUN, 'n' },
-        {"sacerdos", POS::NOUN, 'n' },
-        {"vitae", POS::NOUN, 'n' },
-        {"templum", POS::NOUN, 'n' },
-        {"Romani", POS::NOUN, 'n' },
-        {"ingenium", POS::NOUN, 'n' },
-        {"facies", POS::NOUN, 'n' },
-        {"pugna", POS::NOUN, 'f' },
-        {"dolor", POS::NOUN, 'm' },
-        {"iustitia", POS::NOUN, 'f' },
-        {"membrum", POS::NOUN, 'n' },
-        {"necessitas", POS::NOUN, 'n' },
-        {"aer", POS::NOUN, 'm' },
-        {"flumen", POS::NOUN, 'n' },
-        {"apostolus", POS::NOUN, 'm' },
-        {"copia", POS::NOUN, 'f' },
-        {"Israhel", POS::NOUN, 'n' },
-        {"praetor", POS::NOUN, 'm' },
-        {"aurum", POS::NOUN, 'n' },
-        {"regio", POS::NOUN, 'n' },
-        {"error", POS::NOUN, 'm' },
-        {"angelus", POS::NOUN, 'm' },
-        {"insula", POS::NOUN, 'f' },
-        {"armis", POS::NOUN, 'n' },
-        {"viri", POS::NOUN, 'n' },
-        {"iter", POS::NOUN, 'm' },
-        {"gradus", POS::NOUN, 'm' },
-        {"praesidium", POS::NOUN, 'n' },
-        {"beneficium", POS::NOUN, 'n' },
-        {"filia", POS::NOUN, 'f' },
-        {"vi", POS::NOUN, 'n' },
-        {"ferrum", POS::NOUN, 'n' },
-        {"metus", POS::NOUN, 'm' },
-        {"saeculum", POS::NOUN, 'n' },
-        {"timor", POS::NOUN, 'm' },
-        {"servus", POS::NOUN, 'm' },
-        {"color", POS::NOUN, 'm' },
-        {"initium", POS::NOUN, 'n' },
-        {"spatium", POS::NOUN, 'n' },
-        {"scriptura", POS::NOUN, 'f' },
-        {"fama", POS::NOUN, 'f' },
-        {"meritum", POS::NOUN, 'n' },
-        {"acies", POS::NOUN, 'n' },
-        {"creditor", POS::NOUN, 'm' },
-        {"dos", POS::NOUN, 'n' },
-        {"sacrificium", POS::NOUN, 'n' },
-        {"religio", POS::NOUN, 'n' },
-        {"actus", POS::NOUN, 'm' },
-        {"mensura", POS::NOUN, 'f' },
-        {"episcopus", POS::NOUN, 'm' },
-        {"vis", POS::NOUN, 'n' },
-        {"imago", POS::NOUN, 'n' },
-        {"forum", POS::NOUN, 'n' },
-        {"murus", POS::NOUN, 'm' },
-        {"iussus", POS::NOUN, 'm' },
-        {"viam", POS::NOUN, 'n' },
-        {"consule", POS::NOUN, 'n' },
-        {"propheta", POS::NOUN, 'f' },
-        {"origo", POS::NOUN, 'n' },
-        {"pietas", POS::NOUN, 'n' },
-        {"Domino", POS::NOUN, 'n' },
-        {"semen", POS::NOUN, 'n' },
-        {"vir", POS::NOUN, 'n' },
-        {"lignum", POS::NOUN, 'n' },
-        {"damnum", POS::NOUN, 'n' },
-        {"similitudo", POS::NOUN, 'n' },
-        {"soror", POS::NOUN, 'm' },
-        {"substantia", POS::NOUN, 'f' },
-        {"crimen", POS::NOUN, 'n' },
-        {"ora", POS::NOUN, 'f' },
-        {"femina", POS::NOUN, 'f' },
-        {"philosophus", POS::NOUN, 'm' },
-        {"militia", POS::NOUN, 'f' },
-        {"fatum", POS::NOUN, 'n' },
-        {"civitas", POS::NOUN, 'n' },
-        {"campus", POS::NOUN, 'm' },
-        {"praeda", POS::NOUN, 'f' },
-        {"intellectus", POS::NOUN, 'm' },
-        {"Caesar", POS::NOUN, 'n' },
-        {"culpa", POS::NOUN, 'f' },
-        {"animal", POS::NOUN, 'n' },
-        {"testis", POS::NOUN, 'n' },
-        {"tutor", POS::NOUN, 'm' },
-        {"creatura", POS::NOUN, 'f' },
-        {"via", POS::NOUN, 'f' },
-        {"gladius", POS::NOUN, 'm' },
-        {"Christi", POS::NOUN, 'n' },
-        {"capus", POS::NOUN, 'm' },
-        {"lumen", POS::NOUN, 'n' },
-        {"Romanis", POS::NOUN, 'n' },
-        {"magister", POS::NOUN, 'm' },
-        {"scelus", POS::NOUN, 'm' },
-        {"merces", POS::NOUN, 'n' },
-        {"laus", POS::NOUN, 'm' },
-        {"consuetudo", POS::NOUN, 'n' },
-        {"diabolus", POS::NOUN, 'm' },
-        {"facultas", POS::NOUN, 'n' },
-        {"sedes", POS::NOUN, 'n' },
-        {"emptor", POS::NOUN, 'm' },
-        {"doctrina", POS::NOUN, 'f' },
-        {"porta", POS::NOUN, 'f' },
-        {"mora", POS::NOUN, 'f' },
-        {"praefectus", POS::NOUN, 'm' },
-        {"cibus", POS::NOUN, 'm' },
-        {"praeceptum", POS::NOUN, 'n' },
-        {"verbum", POS::NOUN, 'n' },
-        {"socius", POS::NOUN, 'm' },
-        {"senatum", POS::NOUN, 'n' },
-        {"potentia", POS::NOUN, 'f' },
-        {"sors", POS::NOUN, 'n' },
-        {"fraus", POS::NOUN, 'm' },
-        {"puella", POS::NOUN, 'f' },
-        {"stella", POS::NOUN, 'f' },
-        {"opinio", POS::NOUN, 'n' },
-        {"Christo", POS::NOUN, 'n' },
-        {"misericordia", POS::NOUN, 'f' },
-        {"plebs", POS::NOUN, 'n' },
-        {"arbor", POS::NOUN, 'm' },
-        {"tribunus", POS::NOUN, 'm' },
-        {"procurator", POS::NOUN, 'm' },
-        {"turba", POS::NOUN, 'f' },
-        {"cursus", POS::NOUN, 'm' },
-        {"disciplina", POS::NOUN, 'f' },
-        {"exceptio", POS::NOUN, 'n' },
-        {"consulatus", POS::NOUN, 'm' },
-        {"Romam", POS::NOUN, 'n' },
-        {"profectus", POS::NOUN, 'm' },
-        {"hora", POS::NOUN, 'f' },
-        {"quaestio", POS::NOUN, 'n' },
-        {"fuga", POS::NOUN, 'f' },
-        {"magnitudo", POS::NOUN, 'n' },
-        {"arbitrium", POS::NOUN, 'n' },
-        {"Christus", POS::NOUN, 'm' },
-        {"dolus", POS::NOUN, 'm' },
-        {"effectus", POS::NOUN, 'm' },
-        {"hostis", POS::NOUN, 'n' },
-        {"ecclesia", POS::NOUN, 'f' },
-        {"caedes", POS::NOUN, 'n' },
-        {"epistula", POS::NOUN, 'f' },
-        {"quies", POS::NOUN, 'n' },
-        {"provinciae", POS::NOUN, 'n' },
-        {"Christum", POS::NOUN, 'n' },
-        {"tenebra", POS::NOUN, 'f' },
-        {"Caesaris", POS::NOUN, 'n' },
-        {"praetorium", POS::NOUN, 'n' },
-        {"testimonium", POS::NOUN, 'n' },
-        {"cognitio", POS::NOUN, 'n' },
-        {"voluntate", POS::NOUN, 'n' },
-        {"utilitas", POS::NOUN, 'n' },
-        {"Romae", POS::NOUN, 'n' },
-        {"stipulatio", POS::NOUN, 'n' },
-        {"odium", POS::NOUN, 'n' },
-        {"exitus", POS::NOUN, 'm' },
-        {"aedes", POS::NOUN, 'n' },
-        {"cultus", POS::NOUN, 'm' },
-        {"oleum", POS::NOUN, 'n' },
-        {"creator", POS::NOUN, 'm' },
-        {"debitor", POS::NOUN, 'm' },
-        {"praemium", POS::NOUN, 'n' },
-        {"orbis", POS::NOUN, 'n' },
-        {"cogitatio", POS::NOUN, 'n' },
-        {"philosophia", POS::NOUN, 'f' },
-        {"terminus", POS::NOUN, 'm' },
-        {"societas", POS::NOUN, 'n' },
-        {"servum", POS::NOUN, 'n' },
-        {"instrumentum", POS::NOUN, 'n' },
-        {"voce", POS::NOUN, 'n' },
-        {"circulus", POS::NOUN, 'm' },
-        {"natio", POS::NOUN, 'n' },
-        {"certamen", POS::NOUN, 'n' },
-        {"obsidio", POS::NOUN, 'n' },
-        {"mas", POS::NOUN, 'n' },
-        {"Hierusalem", POS::NOUN, 'n' },
-        {"Romano", POS::NOUN, 'n' },
-        {"legatio", POS::NOUN, 'n' },
-        {"umbra", POS::NOUN, 'f' },
-        {"viris", POS::NOUN, 'n' },
-        {"Italia", POS::NOUN, 'f' },
-        {"flamma", POS::NOUN, 'f' },
-        {"felicitas", POS::NOUN, 'n' },
-        {"pupillus", POS::NOUN, 'm' },
-        {"sacramentum", POS::NOUN, 'n' },
-        {"Romanos", POS::NOUN, 'n' },
-        {"possessor", POS::NOUN, 'm' },
-        {"obligatio", POS::NOUN, 'n' },
-        {"Romanorum", POS::NOUN, 'n' },
-        {"prudentia", POS::NOUN, 'f' },
-        {"mandatum", POS::NOUN, 'n' },
-        {"argumentum", POS::NOUN, 'n' },
-        {"prex", POS::NOUN, 'n' },
-        {"discrimen", POS::NOUN, 'n' },
-        {"testator", POS::NOUN, 'm' },
-        {"amnis", POS::NOUN, 'n' },
-        {"furtum", POS::NOUN, 'n' },
-        {"vim", POS::NOUN, 'n' },
-        {"vitam", POS::NOUN, 'n' },
-        {"matrimonium", POS::NOUN, 'n' },
-        {"Paulus", POS::NOUN, 'm' },
-        {"spons", POS::NOUN, 'n' },
-        {"momentum", POS::NOUN, 'n' },
-        {"virtute", POS::NOUN, 'n' },
-        {"curia", POS::NOUN, 'f' },
-        {"poeta", POS::NOUN, 'f' },
-        {"occasio", POS::NOUN, 'n' },
-        {"pontifex", POS::NOUN, 'n' },
-        {"urbes", POS::NOUN, 'n' },
-        {"circuitus", POS::NOUN, 'm' },
-        {"impetus", POS::NOUN, 'm' },
-        {"turbo", POS::NOUN, 'n' },
-        {"latro", POS::NOUN, 'n' },
-        {"licentia", POS::NOUN, 'f' },
-        {"aequor", POS::NOUN, 'm' },
-        {"principis", POS::NOUN, 'n' },
-        {"argentum", POS::NOUN, 'n' },
-        {"ciuitas", POS::NOUN, 'n' },
-        {"titulus", POS::NOUN, 'm' },
-        {"virorum", POS::NOUN, 'n' },
-        {"desiderium", POS::NOUN, 'n' },
-        {"ripa", POS::NOUN, 'f' },
-        {"pignus", POS::NOUN, 'm' },
-        {"nuptiae", POS::NOUN, 'n' },
-        {"tempestas", POS::NOUN, 'n' },
-        {"supplicium", POS::NOUN, 'n' },
-        {"donum", POS::NOUN, 'n' },
-        {"Italiam", POS::NOUN, 'n' },
-        {"terror", POS::NOUN, 'm' },
-        {"pondus", POS::NOUN, 'm' },
-        {"defensio", POS::NOUN, 'n' },
-        {"frumentum", POS::NOUN, 'n' },
-        {"orator", POS::NOUN, 'm' },
-        {"cornus", POS::NOUN, 'm' },
-        {"defensor", POS::NOUN, 'm' },
-        {"Iudas", POS::NOUN, 'n' },
-    };
+/* Parts are listed in POS enum order */
+constexpr WordTable DEBUG_TABLE = {{{
+    StaticPart<DEBUG_NOUNS>::part(),
+    StaticPart<DEBUG_ADJECTIVES>::part(),
+    StaticPart<DEBUG_VERBS>::part(),
+    StaticPart<DEBUG_ADVERBS>::part(),
+    StaticPart<DEBUG_PREPOSITIONS>::part(),
+    StaticPart<DEBUG_CONJUNCTIONS>::part()
+}}, longest_word<DEBUG_NOUNS, DEBUG_ADJECTIVES, DEBUG_VERBS, DEBUG_ADVERBS, DEBUG_PREPOSITIONS, DEBUG_CONJUNCTIONS>()};
 
-    dict[POS::ADJECTIVE] = {
-        {"hic", POS::ADJECTIVE, 'n' },
-        {"omnis", POS::ADJECTIVE, 'n' },
-        {"alius", POS::ADJECTIVE, 'm' },
-        {"multus", POS::ADJECTIVE, 'm' },
-        {"magnus", POS::ADJECTIVE, 'm' },
-        {"primus", POS::ADJECTIVE, 'm' },
-        {"totus", POS::ADJECTIVE, 'm' },
-        {"bonus", POS::ADJECTIVE, 'm' },
-        {"alter", POS::ADJECTIVE, 'm' },
-        {"summus", POS::ADJECTIVE, 'm' },
-        {"publicus", POS::ADJECTIVE, 'm' },
-        {"ceterus", POS::ADJECTIVE, 'm' },
-        {"solus", POS::ADJECTIVE, 'm' },
-        {"tantus", POS::ADJECTIVE, 'm' },
-        {"medius", POS::ADJECTIVE, 'm' },
-        {"talis", POS::ADJECTIVE, 'n' },
-        {"proprius", POS::ADJECTIVE, 'm' },
-        {"certus", POS::ADJECTIVE, 'm' },
-        {"singulus", POS::ADJECTIVE, 'm' },
-        {"princeps", POS::ADJECTIVE, 'n' },
-        {"similis", POS::ADJECTIVE, 'n' },
-        {"quantum", POS::ADJECTIVE, 'n' },
-        {"communis", POS::ADJECTIVE, 'n' },
-        {"ullus", POS::ADJECTIVE, 'm' },
-        {"humanus", POS::ADJECTIVE, 'm' },
-        {"reliquus", POS::ADJECTIVE, 'm' },
-        {"magne", POS::ADJECTIVE, 'n' },
-        {"secundus", POS::ADJECTIVE, 'm' },
-        {"iustus", POS::ADJECTIVE, 'm' },
-        {"patrius", POS::ADJECTIVE, 'm' },
-        {"malus", POS::ADJECTIVE, 'm' },
-        {"uerus", POS::ADJECTIVE, 'm' },
-        {"proximus", POS::ADJECTIVE, 'm' },
-        {"alienus", POS::ADJECTIVE, 'm' },
-        {"sacer", POS::ADJECTIVE, 'm' },
-        {"cunctus", POS::ADJECTIVE, 'm' },
-        {"superior", POS::ADJECTIVE, 'm' },
-        {"quantus", POS::ADJECTIVE, 'm' },
-        {"par", POS::ADJECTIVE, 'n' },
-        {"altus", POS::ADJECTIVE, 'm' },
-        {"prior", POS::ADJECTIVE, 'm' },
-        {"longus", POS::ADJECTIVE, 'm' },
-        {"paucus", POS::ADJECTIVE, 'm' },
-        {"prius", POS::ADJECTIVE, 'm' },
-        {"plerusque", POS::ADJECTIVE, 'n' },
-        {"necesse", POS::ADJECTIVE, 'n' },
-        {"aeternus", POS::ADJECTIVE, 'm' },
-        {"posterus", POS::ADJECTIVE, 'm' },
-        {"iniurius", POS::ADJECTIVE, 'm' },
-        {"ultimus", POS::ADJECTIVE, 'm' },
-        {"beatus", POS::ADJECTIVE, 'm' },
-        {"exterior", POS::ADJECTIVE, 'm' },
-        {"clarus", POS::ADJECTIVE, 'm' },
-        {"dexter", POS::ADJECTIVE, 'm' },
-        {"miser", POS::ADJECTIVE, 'm' },
-        {"plus", POS::ADJECTIVE, 'm' },
-        {"plenus", POS::ADJECTIVE, 'm' },
-        {"fortis", POS::ADJECTIVE, 'n' },
-        {"antiquus", POS::ADJECTIVE, 'm' },
-        {"nobilis", POS::ADJECTIVE, 'n' },
-        {"inferus", POS::ADJECTIVE, 'm' },
-        {"paulus", POS::ADJECTIVE, 'm' },
-        {"inimicus", POS::ADJECTIVE, 'm' },
-        {"necessarius", POS::ADJECTIVE, 'm' },
-        {"naturalis", POS::ADJECTIVE, 'n' },
-        {"mortalis", POS::ADJECTIVE, 'n' },
-        {"dignus", POS::ADJECTIVE, 'm' },
-        {"tanto", POS::ADJECTIVE, 'n' },
-        {"contrarius", POS::ADJECTIVE, 'm' },
-        {"perpetuus", POS::ADJECTIVE, 'm' },
-        {"integer", POS::ADJECTIVE, 'm' },
-        {"regius", POS::ADJECTIVE, 'm' },
-        {"incertus", POS::ADJECTIVE, 'm' },
-        {"amplus", POS::ADJECTIVE, 'm' },
-        {"nimius", POS::ADJECTIVE, 'm' },
-        {"pauper", POS::ADJECTIVE, 'm' },
-        {"aequus", POS::ADJECTIVE, 'm' },
-        {"ingens", POS::ADJECTIVE, 'n' },
-        {"dubius", POS::ADJECTIVE, 'm' },
-        {"modicus", POS::ADJECTIVE, 'm' },
-        {"facilis", POS::ADJECTIVE, 'n' },
-        {"iulianus", POS::ADJECTIVE, 'm' },
-        {"fidelis", POS::ADJECTIVE, 'n' },
-        {"honestus", POS::ADJECTIVE, 'm' },
-        {"utilis", POS::ADJECTIVE, 'n' },
-        {"vera", POS::ADJECTIVE, 'f' },
-        {"felix", POS::ADJECTIVE, 'n' },
-        {"caelestis", POS::ADJECTIVE, 'n' },
-        {"durus", POS::ADJECTIVE, 'm' },
-        {"continuus", POS::ADJECTIVE, 'm' },
-        {"mirus", POS::ADJECTIVE, 'm' },
-        {"quanto", POS::ADJECTIVE, 'n' },
-        {"penitus", POS::ADJECTIVE, 'm' },
-        {"vestra", POS::ADJECTIVE, 'f' },
-        {"manifestus", POS::ADJECTIVE, 'm' },
-        {"nonnullus", POS::ADJECTIVE, 'm' },
-        {"proprie", POS::ADJECTIVE, 'n' },
-        {"simplex", POS::ADJECTIVE, 'n' },
-        {"suburbanus", POS::ADJECTIVE, 'm' },
-        {"supplex", POS::ADJECTIVE, 'n' },
-        {"idoneus", POS::ADJECTIVE, 'm' },
-        {"divina", POS::ADJECTIVE, 'f' },
-        {"gratus", POS::ADJECTIVE, 'm' },
-        {"commodus", POS::ADJECTIVE, 'm' },
-        {"Romanus", POS::ADJECTIVE, 'm' },
-        {"duplex", POS::ADJECTIVE, 'n' },
-        {"paternus", POS::ADJECTIVE, 'm' },
-        {"turpis", POS::ADJECTIVE, 'n' },
-        {"difficilis", POS::ADJECTIVE, 'n' },
-        {"inanis", POS::ADJECTIVE, 'n' },
-        {"iniquus", POS::ADJECTIVE, 'm' },
-        {"sublimis", POS::ADJECTIVE, 'n' },
-        {"militaris", POS::ADJECTIVE, 'n' },
-        {"terrenus", POS::ADJECTIVE, 'm' },
-        {"universa", POS::ADJECTIVE, 'f' },
-    };
+constexpr WordTable TEST_TABLE = {{{
+    StaticPart<TEST_NOUNS>::part(),
+    StaticPart<TEST_ADJECTIVES>::part(),
+    StaticPart<TEST_VERBS>::part(),
+    StaticPart<TEST_ADVERBS>::part(),
+    StaticPart<TEST_PREPOSITIONS>::part(),
+    StaticPart<TEST_CONJUNCTIONS>::part()
+}}, longest_word<TEST_NOUNS, TEST_ADJECTIVES, TEST_VERBS, TEST_ADVERBS, TEST_PREPOSITIONS, TEST_CONJUNCTIONS>()};
 
-    dict[POS::VERB] = {
-        {"sum", POS::VERB, 'n' },
-        {"facio", POS::VERB, 'n' },
-        {"dico", POS::VERB, 'n' },
-        {"possum", POS::VERB, 'n' },
-        {"habeo", POS::VERB, 'n' },
-        {"do", POS::VERB, 'n' },
-        {"debeo", POS::VERB, 'n' },
-        {"ago", POS::VERB, 'n' },
-        {"accipio", POS::VERB, 'n' },
-        {"quaero", POS::VERB, 'n' },
-        {"scribo", POS::VERB, 'n' },
-        {"credo", POS::VERB, 'n' },
-        {"fero", POS::VERB, 'n' },
-        {"lego", POS::VERB, 'n' },
-        {"mitto", POS::VERB, 'n' },
-        {"scio", POS::VERB, 'n' },
-        {"audio", POS::VERB, 'n' },
-        {"intellego", POS::VERB, 'n' },
-        {"peto", POS::VERB, 'n' },
-        {"sequor", POS::VERB, 'n' },
-        {"puto", POS::VERB, 'n' },
-        {"aio", POS::VERB, 'n' },
-        {"inquam", POS::VERB, 'n' },
-        {"pono", POS::VERB, 'n' },
-        {"relinquo", POS::VERB, 'n' },
-        {"loquor", POS::VERB, 'n' },
-        {"licet", POS::VERB, 'n' },
-        {"morior", POS::VERB, 'n' },
-        {"reddo", POS::VERB, 'n' },
-        {"teneo", POS::VERB, 'n' },
-        {"gero", POS::VERB, 'n' },
-        {"cognosco", POS::VERB, 'n' },
-        {"respondeo", POS::VERB, 'n' },
-        {"utor", POS::VERB, 'n' },
-        {"soleo", POS::VERB, 'n' },
-        {"nascor", POS::VERB, 'n' },
-        {"duco", POS::VERB, 'n' },
-        {"recipio", POS::VERB, 'n' },
-        {"refero", POS::VERB, 'n' },
-        {"patior", POS::VERB, 'n' },
-        {"appello", POS::VERB, 'n' },
-        {"iudico", POS::VERB, 'n' },
-        {"oportet", POS::VERB, 'n' },
-        {"capio", POS::VERB, 'n' },
-        {"contineo", POS::VERB, 'n' },
-        {"trado", POS::VERB, 'n' },
-        {"suscipio", POS::VERB, 'n' },
-        {"occido", POS::VERB, 'n' },
-        {"nosco", POS::VERB, 'n' },
-        {"placeo", POS::VERB, 'n' },
-        {"constituo", POS::VERB, 'n' },
-        {"redeo", POS::VERB, 'n' },
-        {"cogo", POS::VERB, 'n' },
-        {"probo", POS::VERB, 'n' },
-        {"transeo", POS::VERB, 'n' },
-        {"iubeo", POS::VERB, 'n' },
-        {"eo", POS::VERB, 'n' },
-        {"coepio", POS::VERB, 'n' },
-        {"videtur", POS::VERB, 'n' },
-        {"paro", POS::VERB, 'n' },
-        {"promitto", POS::VERB, 'n' },
-        {"ostendo", POS::VERB, 'n' },
-        {"restituo", POS::VERB, 'n' },
-        {"maneo", POS::VERB, 'n' },
-        {"praedico", POS::VERB, 'n' },
-        {"sentio", POS::VERB, 'n' },
-        {"pertineo", POS::VERB, 'n' },
-        {"instituo", POS::VERB, 'n' },
-        {"infero", POS::VERB, 'n' },
-        {"propono", POS::VERB, 'n' },
-        {"praecipio", POS::VERB, 'n' },
-        {"defero", POS::VERB, 'n' },
-        {"doceo", POS::VERB, 'n' },
-        {"offero", POS::VERB, 'n' },
-        {"possideo", POS::VERB, 'n' },
-        {"praesum", POS::VERB, 'n' },
-        {"consto", POS::VERB, 'n' },
-        {"consulo", POS::VERB, 'n' },
-        {"nolo", POS::VERB, 'n' },
-        {"diligo", POS::VERB, 'n' },
-        {"muto", POS::VERB, 'n' },
-        {"confero", POS::VERB, 'n' },
-        {"amo", POS::VERB, 'n' },
-        {"prohibeo", POS::VERB, 'n' },
-        {"sto", POS::VERB, 'n' },
-        {"consequor", POS::VERB, 'n' },
-        {"efficio", POS::VERB, 'n' },
-        {"appareo", POS::VERB, 'n' },
-        {"sumo", POS::VERB, 'n' },
-        {"curo", POS::VERB, 'n' },
-        {"timeo", POS::VERB, 'n' },
-        {"nego", POS::VERB, 'n' },
-        {"libero", POS::VERB, 'n' },
-        {"mereo", POS::VERB, 'n' },
-        {"tollo", POS::VERB, 'n' },
-        {"absum", POS::VERB, 'n' },
-        {"occupo", POS::VERB, 'n' },
-        {"exsisto", POS::VERB, 'n' },
-        {"traho", POS::VERB, 'n' },
-        {"significo", POS::VERB, 'n' },
-        {"defendo", POS::VERB, 'n' },
-        {"nomino", POS::VERB, 'n' },
-        {"cogito", POS::VERB, 'n' },
-        {"audeo", POS::VERB, 'n' },
-        {"committo", POS::VERB, 'n' },
-        {"concedo", POS::VERB, 'n' },
-        {"ingredior", POS::VERB, 'n' },
-        {"pereo", POS::VERB, 'n' },
-        {"desum", POS::VERB, 'n' },
-        {"adsum", POS::VERB, 'n' },
-        {"addo", POS::VERB, 'n' },
-        {"oro", POS::VERB, 'n' },
-        {"dubito", POS::VERB, 'n' },
-        {"intersum", POS::VERB, 'n' },
-        {"accido", POS::VERB, 'n' },
-        {"eligo", POS::VERB, 'n' },
-        {"colo", POS::VERB, 'n' },
-        {"depono", POS::VERB, 'n' },
-        {"procedo", POS::VERB, 'n' },
-        {"venit", POS::VERB, 'n' },
-        {"permitto", POS::VERB, 'n' },
-        {"spero", POS::VERB, 'n' },
-        {"egredior", POS::VERB, 'n' },
-        {"sustineo", POS::VERB, 'n' },
-        {"accedo", POS::VERB, 'n' },
-        {"retineo", POS::VERB, 'n' },
-        {"deduco", POS::VERB, 'n' },
-        {"misceo", POS::VERB, 'n' },
-        {"ignoro", POS::VERB, 'n' },
-        {"amitto", POS::VERB, 'n' },
-        {"existimo", POS::VERB, 'n' },
-        {"dono", POS::VERB, 'n' },
-        {"irascor", POS::VERB, 'n' },
-        {"esse", POS::VERB, 'n' },
-        {"praebeo", POS::VERB, 'n' },
-        {"nescio", POS::VERB, 'n' },
-        {"potior", POS::VERB, 'n' },
-        {"cado", POS::VERB, 'n' },
-        {"competo", POS::VERB, 'n' },
-        {"fugio", POS::VERB, 'n' },
-        {"rogo", POS::VERB, 'n' },
-        {"persequor", POS::VERB, 'n' },
-        {"dimitto", POS::VERB, 'n' },
-        {"subeo", POS::VERB, 'n' },
-        {"postulo", POS::VERB, 'n' },
-        {"statuo", POS::VERB, 'n' },
-        {"tribuo", POS::VERB, 'n' },
-        {"impleo", POS::VERB, 'n' },
-        {"aperio", POS::VERB, 'n' },
-        {"defungor", POS::VERB, 'n' },
-        {"contingo", POS::VERB, 'n' },
-        {"exigo", POS::VERB, 'n' },
-        {"sedeo", POS::VERB, 'n' },
-        {"condo", POS::VERB, 'n' },
-        {"laudo", POS::VERB, 'n' },
-        {"excipio", POS::VERB, 'n' },
-        {"nuntio", POS::VERB, 'n' },
-        {"disco", POS::VERB, 'n' },
-        {"gigno", POS::VERB, 'n' },
-        {"rego", POS::VERB, 'n' },
-        {"specto", POS::VERB, 'n' },
-        {"confiteor", POS::VERB, 'n' },
-        {"abeo", POS::VERB, 'n' },
-        {"pugno", POS::VERB, 'n' },
-        {"taceo", POS::VERB, 'n' },
-        {"affero", POS::VERB, 'n' },
-        {"consisto", POS::VERB, 'n' },
-        {"censeo", POS::VERB, 'n' },
-        {"uoco", POS::VERB, 'n' },
-        {"magistro", POS::VERB, 'n' },
-        {"cedo", POS::VERB, 'n' },
-        {"profero", POS::VERB, 'n' },
-        {"descendo", POS::VERB, 'n' },
-        {"ascendo", POS::VERB, 'n' },
-        {"edo", POS::VERB, 'n' },
-        {"instruo", POS::VERB, 'n' },
-        {"obligo", POS::VERB, 'n' },
-        {"impero", POS::VERB, 'n' },
-        {"dispono", POS::VERB, 'n' },
-        {"delinquo", POS::VERB, 'n' },
-        {"praetereo", POS::VERB, 'n' },
-        {"intro", POS::VERB, 'n' },
-        {"decedo", POS::VERB, 'n' },
-        {"obtineo", POS::VERB, 'n' },
-        {"numero", POS::VERB, 'n' },
-        {"repeto", POS::VERB, 'n' },
-        {"percipio", POS::VERB, 'n' },
-        {"mando", POS::VERB, 'n' },
-        {"contraho", POS::VERB, 'n' },
-        {"loco", POS::VERB, 'n' },
-        {"supero", POS::VERB, 'n' },
-        {"corrumpo", POS::VERB, 'n' },
-        {"furor", POS::VERB, 'n' },
-        {"coniungo", POS::VERB, 'n' },
-        {"admitto", POS::VERB, 'n' },
-        {"tempto", POS::VERB, 'n' },
-        {"aufero", POS::VERB, 'n' },
-        {"exspecto", POS::VERB, 'n' },
-        {"praefero", POS::VERB, 'n' },
-        {"damno", POS::VERB, 'n' },
-        {"resisto", POS::VERB, 'n' },
-        {"pateo", POS::VERB, 'n' },
-        {"creo", POS::VERB, 'n' },
-        {"discedo", POS::VERB, 'n' },
-        {"exhibeo", POS::VERB, 'n' },
-        {"regno", POS::VERB, 'n' },
-        {"concipio", POS::VERB, 'n' },
-        {"videri", POS::VERB, 'n' },
-        {"cupio", POS::VERB, 'n' },
-        {"arbitror", POS::VERB, 'n' },
-        {"desidero", POS::VERB, 'n' },
-        {"iungo", POS::VERB, 'n' },
-        {"deficio", POS::VERB, 'n' },
-        {"convenit", POS::VERB, 'n' },
-        {"definio", POS::VERB, 'n' },
-        {"cesso", POS::VERB, 'n' },
-        {"aestimo", POS::VERB, 'n' },
-        {"perdo", POS::VERB, 'n' },
-        {"fundo", POS::VERB, 'n' },
-        {"comparo", POS::VERB, 'n' },
-        {"remitto", POS::VERB, 'n' },
-        {"adhibeo", POS::VERB, 'n' },
-        {"dirigo", POS::VERB, 'n' },
-        {"expedio", POS::VERB, 'n' },
-        {"oppono", POS::VERB, 'n' },
-        {"interrogo", POS::VERB, 'n' },
-        {"pario", POS::VERB, 'n' },
-        {"conficio", POS::VERB, 'n' },
-        {"adicio", POS::VERB, 'n' },
-        {"transfero", POS::VERB, 'n' },
-        {"tracto", POS::VERB, 'n' },
-        {"cito", POS::VERB, 'n' },
-        {"incipio", POS::VERB, 'n' },
-        {"demonstro", POS::VERB, 'n' },
-        {"opprimo", POS::VERB, 'n' },
-        {"nitor", POS::VERB, 'n' },
-        {"differo", POS::VERB, 'n' },
-        {"compono", POS::VERB, 'n' },
-        {"impono", POS::VERB, 'n' },
-        {"custodio", POS::VERB, 'n' },
-        {"sufficio", POS::VERB, 'n' },
-        {"exeo", POS::VERB, 'n' },
-        {"finio", POS::VERB, 'n' },
-        {"lateo", POS::VERB, 'n' },
-        {"emo", POS::VERB, 'n' },
-        {"noceo", POS::VERB, 'n' },
-        {"habito", POS::VERB, 'n' },
-        {"rescribo", POS::VERB, 'n' },
-        {"decerno", POS::VERB, 'n' },
-        {"pronuntio", POS::VERB, 'n' },
-        {"considero", POS::VERB, 'n' },
-        {"destino", POS::VERB, 'n' },
-        {"confirmo", POS::VERB, 'n' },
-        {"proficiscor", POS::VERB, 'n' },
-        {"occurro", POS::VERB, 'n' },
-        {"intendo", POS::VERB, 'n' },
-        {"miror", POS::VERB, 'n' },
-        {"venire", POS::VERB, 'n' },
-        {"iaceo", POS::VERB, 'n' },
-        {"tego", POS::VERB, 'n' },
-        {"adduco", POS::VERB, 'n' },
-        {"contendo", POS::VERB, 'n' },
-        {"tango", POS::VERB, 'n' },
-        {"congrego", POS::VERB, 'n' },
-        {"impedio", POS::VERB, 'n' },
-        {"pecco", POS::VERB, 'n' },
-        {"armo", POS::VERB, 'n' },
-        {"induco", POS::VERB, 'n' },
-        {"insum", POS::VERB, 'n' },
-        {"careo", POS::VERB, 'n' },
-        {"como", POS::VERB, 'n' },
-        {"desero", POS::VERB, 'n' },
-        {"excito", POS::VERB, 'n' },
-        {"expugno", POS::VERB, 'n' },
-        {"impetro", POS::VERB, 'n' },
-        {"iuro", POS::VERB, 'n' },
-        {"adquiro", POS::VERB, 'n' },
-        {"accuso", POS::VERB, 'n' },
-        {"occulo", POS::VERB, 'n' },
-        {"laboro", POS::VERB, 'n' },
-        {"edico", POS::VERB, 'n' },
-        {"effundo", POS::VERB, 'n' },
-        {"pendeo", POS::VERB, 'n' },
-        {"expono", POS::VERB, 'n' },
-        {"voluit", POS::VERB, 'n' },
-        {"remaneo", POS::VERB, 'n' },
-        {"orior", POS::VERB, 'n' },
-        {"interdico", POS::VERB, 'n' },
-        {"perduco", POS::VERB, 'n' },
-        {"monstro", POS::VERB, 'n' },
-        {"erro", POS::VERB, 'n' },
-        {"colligo", POS::VERB, 'n' },
-        {"prodeo", POS::VERB, 'n' },
-        {"tempero", POS::VERB, 'n' },
-        {"moneo", POS::VERB, 'n' },
-        {"pector", POS::VERB, 'n' },
-        {"decet", POS::VERB, 'n' },
-        {"neglego", POS::VERB, 'n' },
-        {"incido", POS::VERB, 'n' },
-        {"adoro", POS::VERB, 'n' },
-        {"testor", POS::VERB, 'n' },
-        {"auro", POS::VERB, 'n' },
-        {"reperio", POS::VERB, 'n' },
-        {"indico", POS::VERB, 'n' },
-        {"extendo", POS::VERB, 'n' },
-        {"fallo", POS::VERB, 'n' },
-        {"requiro", POS::VERB, 'n' },
-        {"succedo", POS::VERB, 'n' },
-        {"videntur", POS::VERB, 'n' },
-        {"emitto", POS::VERB, 'n' },
-        {"commendo", POS::VERB, 'n' },
-        {"experior", POS::VERB, 'n' },
-        {"paco", POS::VERB, 'n' },
-        {"celebro", POS::VERB, 'n' },
-        {"memoro", POS::VERB, 'n' },
-        {"tergo", POS::VERB, 'n' },
-        {"interficio", POS::VERB, 'n' },
-        {"quiesco", POS::VERB, 'n' },
-        {"praeparo", POS::VERB, 'n' },
-        {"videatur", POS::VERB, 'n' },
-        {"sino", POS::VERB, 'n' },
-        {"exerceo", POS::VERB, 'n' },
-        {"comedo", POS::VERB, 'n' },
-        {"excello", POS::VERB, 'n' },
-        {"comprehendo", POS::VERB, 'n' },
-        {"praepono", POS::VERB, 'n' },
-        {"impendo", POS::VERB, 'n' },
-        {"desino", POS::VERB, 'n' },
-        {"prosum", POS::VERB, 'n' },
-        {"consumo", POS::VERB, 'n' },
-        {"subicio", POS::VERB, 'n' },
-        {"munio", POS::VERB, 'n' },
-        {"rapio", POS::VERB, 'n' },
-        {"oppugno", POS::VERB, 'n' },
-        {"gaudeo", POS::VERB, 'n' },
-        {"subdo", POS::VERB, 'n' },
-        {"opinor", POS::VERB, 'n' },
-        {"respicio", POS::VERB, 'n' },
-        {"adiungo", POS::VERB, 'n' },
-        {"condemno", POS::VERB, 'n' },
-        {"inclino", POS::VERB, 'n' },
-        {"parco", POS::VERB, 'n' },
-        {"ordino", POS::VERB, 'n' },
-        {"patro", POS::VERB, 'n' },
-        {"punio", POS::VERB, 'n' },
-        {"animo", POS::VERB, 'n' },
-        {"clamo", POS::VERB, 'n' },
-        {"praemitto", POS::VERB, 'n' },
-        {"excedo", POS::VERB, 'n' },
-        {"separo", POS::VERB, 'n' },
-        {"vult", POS::VERB, 'n' },
-        {"memini", POS::VERB, 'n' },
-        {"declino", POS::VERB, 'n' },
-        {"distinguo", POS::VERB, 'n' },
-        {"minuo", POS::VERB, 'n' },
-        {"sapio", POS::VERB, 'n' },
-        {"reficio", POS::VERB, 'n' },
-        {"agnosco", POS::VERB, 'n' },
-        {"cerno", POS::VERB, 'n' },
-        {"recedo", POS::VERB, 'n' },
-        {"educo", POS::VERB, 'n' },
-    };
+template <size_t N>
+void add_words(Dictionary& dict, const StaticWord (&list)[N]) {
+    auto& words = dict[list[0].pos];
+    for (size_t i = 0; i < N; i++) {
+        const StaticWord& word = list[i];
+        words.push_back({std::string(word.text), word.pos, word.gender, rank_weight(word, i)});
+    }
+}
 
-    dict[POS::ADVERB] = {
-        {"etiam", POS::ADVERB, 'n' },
-        {"ita", POS::ADVERB, 'n' },
-        {"iam", POS::ADVERB, 'n' },
-        {"quoque", POS::ADVERB, 'n' },
-        {"quidem", POS::ADVERB, 'n' },
-        {"vero", POS::ADVERB, 'n' },
-        {"nunc", POS::ADVERB, 'n' },
-        {"sic", POS::ADVERB, 'n' },
-        {"ubi", POS::ADVERB, 'n' },
-        {"tam", POS::ADVERB, 'n' },
-        {"ergo", POS::ADVERB, 'n' },
-        {"tantum", POS::ADVERB, 'n' },
-        {"tum", POS::ADVERB, 'n' },
-        {"magis", POS::ADVERB, 'n' },
-        {"minus", POS::ADVERB, 'n' },
-        {"usque", POS::ADVERB, 'n' },
-        {"solum", POS::ADVERB, 'n' },
-        {"semper", POS::ADVERB, 'n' },
-        {"praesto", POS::ADVERB, 'n' },
-        {"satis", POS::ADVERB, 'n' },
-        {"deinde", POS::ADVERB, 'n' },
-        {"inde", POS::ADVERB, 'n' },
-        {"ideo", POS::ADVERB, 'n' },
-        {"tunc", POS::ADVERB, 'n' },
-        {"unde", POS::ADVERB, 'n' },
-        {"adhuc", POS::ADVERB, 'n' },
-        {"postea", POS::ADVERB, 'n' },
-        {"ibi", POS::ADVERB, 'n' },
-        {"simul", POS::ADVERB, 'n' },
-        {"itaque", POS::ADVERB, 'n' },
-        {"bene", POS::ADVERB, 'n' },
-        {"numquam", POS::ADVERB, 'n' },
-        {"tamquam", POS::ADVERB, 'n' },
-        {"potius", POS::ADVERB, 'n' },
-        {"adeo", POS::ADVERB, 'n' },
-        {"scilicet", POS::ADVERB, 'n' },
-        {"hinc", POS::ADVERB, 'n' },
-        {"utique", POS::ADVERB, 'n' },
-        {"statim", POS::ADVERB, 'n' },
-        {"cur", POS::ADVERB, 'n' },
-        {"item", POS::ADVERB, 'n' },
-        {"multo", POS::ADVERB, 'n' },
-        {"iusum", POS::ADVERB, 'n' },
-        {"omnino", POS::ADVERB, 'n' },
-        {"certe", POS::ADVERB, 'n' },
-        {"verum", POS::ADVERB, 'n' },
-        {"saepe", POS::ADVERB, 'n' },
-        {"longe", POS::ADVERB, 'n' },
-        {"haud", POS::ADVERB, 'n' },
-        {"mox", POS::ADVERB, 'n' },
-        {"diu", POS::ADVERB, 'n' },
-        {"rursus", POS::ADVERB, 'n' },
-        {"tandem", POS::ADVERB, 'n' },
-        {"fere", POS::ADVERB, 'n' },
-        {"quamvis", POS::ADVERB, 'n' },
-        {"ample", POS::ADVERB, 'n' },
-        {"recte", POS::ADVERB, 'n' },
-        {"interim", POS::ADVERB, 'n' },
-        {"multum", POS::ADVERB, 'n' },
-        {"umquam", POS::ADVERB, 'n' },
-        {"iterum", POS::ADVERB, 'n' },
-        {"aliquando", POS::ADVERB, 'n' },
-        {"denique", POS::ADVERB, 'n' },
-        {"nondum", POS::ADVERB, 'n' },
-        {"parum", POS::ADVERB, 'n' },
-        {"huiusmodi", POS::ADVERB, 'n' },
-        {"velut", POS::ADVERB, 'n' },
-        {"quin", POS::ADVERB, 'n' },
-        {"quemadmodum", POS::ADVERB, 'n' },
-        {"male", POS::ADVERB, 'n' },
-        {"pariter", POS::ADVERB, 'n' },
-        {"facile", POS::ADVERB, 'n' },
-        {"quomodo", POS::ADVERB, 'n' },
-        {"aliter", POS::ADVERB, 'n' },
-        {"veluti", POS::ADVERB, 'n' },
-        {"diligenter", POS::ADVERB, 'n' },
-        {"coram", POS::ADVERB, 'n' },
-        {"videlicet", POS::ADVERB, 'n' },
-        {"hodie", POS::ADVERB, 'n' },
-        {"cumque", POS::ADVERB, 'n' },
-        {"quotiens", POS::ADVERB, 'n' },
-        {"saepius", POS::ADVERB, 'n' },
-        {"profecto", POS::ADVERB, 'n' },
-        {"vix", POS::ADVERB, 'n' },
-        {"primo", POS::ADVERB, 'n' },
-        {"tantummodo", POS::ADVERB, 'n' },
-        {"procul", POS::ADVERB, 'n' },
-        {"vere", POS::ADVERB, 'n' },
-        {"praeterea", POS::ADVERB, 'n' },
-        {"sane", POS::ADVERB, 'n' },
-        {"immo", POS::ADVERB, 'n' },
-        {"quare", POS::ADVERB, 'n' },
-        {"nonne", POS::ADVERB, 'n' },
-        {"olim", POS::ADVERB, 'n' },
-        {"porro", POS::ADVERB, 'n' },
-        {"valde", POS::ADVERB, 'n' },
-        {"semel", POS::ADVERB, 'n' },
-        {"protinus", POS::ADVERB, 'n' },
-        {"nimis", POS::ADVERB, 'n' },
-        {"ultro", POS::ADVERB, 'n' },
-        {"plane", POS::ADVERB, 'n' },
-        {"prae", POS::ADVERB, 'n' },
-    };
+} /* namespace */
 
-    dict[POS::CONJUNCTION] = {
-        {"et", POS::CONJUNCTION, 'n' },
-        {"ut", POS::CONJUNCTION, 'n' },
-        {"si", POS::CONJUNCTION, 'n' },
-        {"sed", POS::CONJUNCTION, 'n' },
-        {"atque", POS::CONJUNCTION, 'n' },
-        {"quod", POS::CONJUNCTION, 'n' },
-        {"enim", POS::CONJUNCTION, 'n' },
-        {"aut", POS::CONJUNCTION, 'n' },
-        {"autem", POS::CONJUNCTION, 'n' },
-        {"nec", POS::CONJUNCTION, 'n' },
-        {"quam", POS::CONJUNCTION, 'n' },
-        {"vel", POS::CONJUNCTION, 'n' },
-        {"quia", POS::CONJUNCTION, 'n' },
-        {"tamen", POS::CONJUNCTION, 'n' },
-        {"ne", POS::CONJUNCTION, 'n' },
-        {"neque", POS::CONJUNCTION, 'n' },
-        {"nisi", POS::CONJUNCTION, 'n' },
-        {"sicut", POS::CONJUNCTION, 'n' },
-        {"nam", POS::CONJUNCTION, 'n' },
-        {"igitur", POS::CONJUNCTION, 'n' },
-        {"an", POS::CONJUNCTION, 'n' },
-        {"quasi", POS::CONJUNCTION, 'n' },
-        {"sive", POS::CONJUNCTION, 'n' },
-        {"dum", POS::CONJUNCTION, 'n' },
-        {"quoniam", POS::CONJUNCTION, 'n' },
-        {"quando", POS::CONJUNCTION, 'n' },
-        {"siue", POS::CONJUNCTION, 'n' },
-        {"at", POS::CONJUNCTION, 'n' },
-        {"utrum", POS::CONJUNCTION, 'n' },
-        {"postquam", POS::CONJUNCTION, 'n' },
-        {"donec", POS::CONJUNCTION, 'n' },
-        {"etsi", POS::CONJUNCTION, 'n' },
-        {"quamquam", POS::CONJUNCTION, 'n' },
-        {"antequam", POS::CONJUNCTION, 'n' },
-        {"priusquam", POS::CONJUNCTION, 'n' },
-    };
+const WordTable& get_debug_word_table() {
+    return DEBUG_TABLE;
+}
 
-    dict[POS::PREPOSITION] = {
-        {"in", POS::PREPOSITION, 'n' },
-        {"ad", POS::PREPOSITION, 'n' },
-        {"ab", POS::PREPOSITION, 'n' },
-        {"cum", POS::PREPOSITION, 'n' },
-        {"de", POS::PREPOSITION, 'n' },
-        {"ex", POS::PREPOSITION, 'n' },
-        {"per", POS::PREPOSITION, 'n' },
-        {"pro", POS::PREPOSITION, 'n' },
-        {"inter", POS::PREPOSITION, 'n' },
-        {"sine", POS::PREPOSITION, 'n' },
-        {"ante", POS::PREPOSITION, 'n' },
-        {"post", POS::PREPOSITION, 'n' },
-        {"apud", POS::PREPOSITION, 'n' },
-        {"super", POS::PREPOSITION, 'n' },
-        {"contra", POS::PREPOSITION, 'n' },
-        {"propter", POS::PREPOSITION, 'n' },
-        {"sub", POS::PREPOSITION, 'n' },
-        {"secundum", POS::PREPOSITION, 'n' },
-        {"ob", POS::PREPOSITION, 'n' },
-        {"adversus", POS::PREPOSITION, 'n' },
-        {"supra", POS::PREPOSITION, 'n' },
-        {"circa", POS::PREPOSITION, 'n' },
-        {"intra", POS::PREPOSITION, 'n' },
-        {"praeter", POS::PREPOSITION, 'n' },
-        {"ultra", POS::PREPOSITION, 'n' },
-        {"prope", POS::PREPOSITION, 'n' },
-        {"extra", POS::PREPOSITION, 'n' },
-        {"iuxta", POS::PREPOSITION, 'n' },
-        {"penes", POS::PREPOSITION, 'n' },
-    };
+const WordTable& get_test_word_table() {
+    return TEST_TABLE;
+}
 
+Dictionary get_debug_dictionary() {
+    Dictionary dict;
+    add_words(dict, DEBUG_NOUNS);
+    add_words(dict, DEBUG_ADJECTIVES);
+    add_words(dict, DEBUG_VERBS);
+    add_words(dict, DEBUG_ADVERBS);
+    add_words(dict, DEBUG_PREPOSITIONS);
+    add_words(dict, DEBUG_CONJUNCTIONS);
     return dict;
 }
 
+Dictionary get_test_dictionary() {
+    Dictionary dict;
+    add_words(dict, TEST_NOUNS);
+    add_words(dict, TEST_ADJECTIVES);
+    add_words(dict, TEST_VERBS);
+    add_words(dict, TEST_ADVERBS);
+    add_words(dict, TEST_CONJUNCTIONS);
+    add_words(dict, TEST_PREPOSITIONS);
+    return dict;
+}
@@ -2,9 +2,18 @@
 #define DICTIONARY_HPP
 
 #include "types.hpp"
+#include "wordtable.hpp"
 
 Dictionary get_test_dictionary();
 
 Dictionary get_debug_dictionary();
 
+/**
+ * The built-in vocabularies as static, compile-time tables. Selecting from these costs
+ * nothing at startup; the Dictionary versions above are built from the same data.
+ */
+const WordTable& get_test_word_table();
+
+const WordTable& get_debug_word_table();
+
 #endif
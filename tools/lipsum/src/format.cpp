@@ -0,0 +1,104 @@
+#include "format.hpp"
+#include <array>
+#include <cstdio>
+
+namespace {
+
+using EscapeTable = std::array<std::string, 256>;
+
+Scan::ByteSet specials(const EscapeTable& escapes) {
+    Scan::ByteSet set = {};
+    set.controls = !escapes[0].empty();
+    for (size_t c = set.controls ? 0x20 : 0; c < escapes.size(); c++) {
+        if (!escapes[c].empty() && set.count < sizeof(set.bytes))
+            set.bytes[set.count++] = static_cast<char>(c);
+    }
+    return set;
+}
+
+EscapeTable html_escapes() {
+    EscapeTable table;
+    table['&'] = "&amp;";
+    table['<'] = "&lt;";
+    table['>'] = "&gt;";
+    return table;
+}
+
+/* Backslash escapes for the punctuation that could start or end inline markup or a block (at most 16) */
+EscapeTable markdown_escapes() {
+    EscapeTable table;
+    for (char c : std::string_view("\\`*_[]<>#&|"))
+        table[static_cast<unsigned char>(c)] = std::string("\\") + c;
+    return table;
+}
+
+EscapeTable json_escapes() {
+    EscapeTable table;
+    for (int c = 0; c < 0x20; c++) {
+        char escape[8];
+        std::snprintf(escape, sizeof(escape), "\\u%04x", c);
+        table[c] = escape;
+    }
+    table['"'] = "\\\"";
+    table['\\'] = "\\\\";
+    return table;
+}
+
+} /* namespace */
+
+const Markup& markup(Format format) {
+    static const EscapeTable html = html_escapes();
+    static const EscapeTable markdown = markdown_escapes();
+    static const EscapeTable json = json_escapes();
+
+    static const Markup HTML = {
+        "<!DOCTYPE html>\n<html>\n<head><meta charset=\"utf-8\"><title>Lorem Ipsum</title></head>\n<body>\n",
+        "\n</body>\n</html>",
+        "\n",
+        "<h2>", "</h2>",
+        "<p>", "</p>", " ",
+        "<ul>\n<li>", "</li>\n<li>", "</li>\n</ul>",
+        true,
+        html.data(), specials(html)
+    };
+    static const Markup MARKDOWN = {
+        "", "",
+        "\n\n",
+        "## ", "",
+        "", "", " ",
+        "- ", "\n- ", "",
+        true,
+        markdown.data(), specials(markdown)
+    };
+    /* An array of paragraphs, each an array of sentence strings */
+    static const Markup JSON = {
+        "[\n", "\n]",
+        ",\n",
+        "", "",
+        "[\"", "\"]", "\", \"",
+        "", "", "",
+        false,
+        json.data(), specials(json)
+    };
+
+    switch (format) {
+    case Format::HTML:     return HTML;
+    case Format::MARKDOWN: return MARKDOWN;
+    default:               return JSON;
+    }
+}
+
+bool parse_format(const std::string& name, Format& format) {
+    if (name == "text") {
+        format = Format::TEXT;
+    } else if (name == "html") {
+        format = Format::HTML;
+    } else if (name == "markdown") {
+        format = Format::MARKDOWN;
+    } else if (name == "json") {
+        format = Format::JSON;
+    } else {
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,61 @@
+#ifndef FORMAT_HPP
+#define FORMAT_HPP
+
+#include "scan.hpp"
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * @file format.hpp
+ * @brief Markup that OutputWriter wraps around paragraphs and sentences (--format).
+ *
+ * Documents are laid out in sections of Config::FORMAT_SECTION_PARAGRAPHS paragraphs.
+ * With headings and lists, the first sentence of a section's first paragraph is the
+ * section heading, the paragraph halfway through a section is a list with one item per
+ * sentence, and every other paragraph is a plain block. The words are the plain-text
+ * output's words in the same order; only the markup around them and the escaping
+ * differ.
+ */
+
+enum class Format {
+    TEXT,
+    HTML,
+    MARKDOWN,
+    JSON
+};
+
+/**
+ * @brief The strings a format puts around the text. Empty strings add nothing.
+ */
+struct Markup {
+    std::string_view document_open;
+    std::string_view document_close;
+    std::string_view block_separator;    /* Between a block's close and the next one's open */
+    std::string_view heading_open;
+    std::string_view heading_close;
+    std::string_view paragraph_open;
+    std::string_view paragraph_close;
+    std::string_view sentence_separator; /* Between the sentences of a plain block */
+    std::string_view list_open;
+    std::string_view list_item_separator;
+    std::string_view list_close;
+    bool             sections;           /* Headings and lists; otherwise every paragraph is plain */
+
+    /* What byte @p c of the text is written as; empty if it is written as it is */
+    std::string_view escape(char c) const { return escapes[static_cast<unsigned char>(c)]; }
+
+    const std::string* escapes;          /* 256 entries */
+    Scan::ByteSet      specials;         /* The bytes with an escape */
+};
+
+/* Markup for one of the formats other than TEXT */
+const Markup& markup(Format format);
+
+/**
+ * Parses a format name ("text", "html", "markdown" or "json"). Returns false for
+ * unknown names.
+ **/
+bool parse_format(const std::string& name, Format& format);
+
+#endif
@@ -0,0 +1,336 @@
+#include "generate.hpp"
+#include "config.hpp"
+#include "grammar.hpp"
+#include "lexicon.hpp"
+#include "markov.hpp"
+#include "output.hpp"
+#include "parallel.hpp"
+#include "random.hpp"
+#include "sink.hpp"
+#include "source.hpp"
+#include "stats.hpp"
+#include "text.hpp"
+#include "types.hpp"
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+using namespace GrammarNS;
+
+namespace {
+
+const std::string LOREM_IPSUM =
+    "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. "
+    "Ut enim ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea commodo consequat. "
+    "Duis aute irure dolor in reprehenderit in voluptate velit esse cillum dolore eu fugiat nulla pariatur. "
+    "Excepteur sint occaecat cupidatat non proident, sunt in culpa qui officia deserunt mollit anim id est laborum.";
+
+/**
+ * Appends paragraphs to @p base until it holds @p targetCount of them. The running count
+ * starts from @p currentCount and is advanced per paragraph instead of re-counting.
+ **/
+std::string appendParagraphsUntil(const std::string &base, size_t currentCount, int targetCount,
+                                  const std::string &separator, TextSource &source) {
+    std::string output = base;
+    TextStats stats;
+    stats.paragraphs = currentCount;
+    while ((int)stats.paragraphs < targetCount) {
+        std::string_view paragraph = source.next_paragraph(stats);
+        if (!output.empty())
+            output += separator;
+        output += paragraph;
+    }
+    return output;
+}
+
+/* Sizing flags are applied in this order; only the last one given may stream its growth. */
+enum class Sizing {
+    NONE,
+    PARAGRAPHS,
+    SENTENCES,
+    WORDS,
+    CHARACTERS,
+    BYTES
+};
+
+Sizing lastSizing(const Options& opts) {
+    if (opts.byte_exclusive)   return Sizing::BYTES;
+    if (opts.characters != -1) return Sizing::CHARACTERS;
+    if (opts.words != -1)      return Sizing::WORDS;
+    if (opts.sentences != -1)  return Sizing::SENTENCES;
+    if (opts.paragraphs != -1) return Sizing::PARAGRAPHS;
+    return Sizing::NONE;
+}
+
+/**
+ * Streaming counterpart of appendParagraphsUntil(): paragraphs go straight to the writer
+ * instead of being collected, so memory stays bounded no matter how many are requested.
+ **/
+void streamParagraphsUntil(OutputWriter &out, size_t currentCount, size_t targetCount,
+                           const std::string &separator, TextSource &source) {
+    TextStats stats;
+    stats.paragraphs = currentCount;
+    while (stats.paragraphs < targetCount) {
+        std::string_view paragraph = source.next_paragraph(stats);
+        if (out.size() > 0)
+            out.write(separator);
+        out.write(paragraph);
+    }
+}
+
+/**
+ * Writes batches of generated sentences to @p out, each preceded by a separator, for as
+ * long as @p batch_size (given the running @p stats) asks for more than zero.
+ **/
+template <typename BatchSize>
+void streamSentences(OutputWriter &out, TextSource &source, TextStats &stats, BatchSize batch_size) {
+    std::string batch;
+    for (size_t count; (count = batch_size(stats)) > 0;) {
+        batch.clear();
+        source.generate_sentences(count, batch, stats);
+        out.write(" ");
+        out.write(batch);
+    }
+}
+
+/* Batch size for the rest of @p needed sentences */
+size_t sentenceBatch(size_t sentences, size_t needed) {
+    return sentences < needed ? std::min(needed - sentences, Config::SENTENCE_BATCH) : 0;
+}
+
+/**
+ * Batch size for the rest of @p needed words. No sentence has more than
+ * @p sentence_words words, so the batch never overshoots the sentence that reaches the
+ * target and later phases see the same random state as with one sentence at a time.
+ **/
+size_t wordBatch(size_t words, size_t needed, size_t sentence_words) {
+    if (words >= needed)
+        return 0;
+    return std::clamp<size_t>((needed - words) / sentence_words, 1, Config::SENTENCE_BATCH);
+}
+
+/**
+ * Writes @p text and then generated sentences until exactly @p size bytes of normalized
+ * text (not counting the final newline) have been emitted. The writer counts bytes as it
+ * normalizes them and stops mid-sentence at the cap, so no sentence past the one that
+ * fills the budget is generated and no second pass has to trim the result.
+ **/
+void fillToSize(OutputWriter &out, const std::string &text, long long size, TextSource &source) {
+    const size_t limit = size > 0 ? static_cast<size_t>(size) : 0;
+    out.set_limit(limit);
+    out.write(text);
+    TextStats stats;
+    /* Sized from the average sentence so far to stop close to the one that fills the cap */
+    streamSentences(out, source, stats, [&](const TextStats &done) -> size_t {
+        if (out.full())
+            return 0;
+        if (done.sentences == 0)
+            return 1;
+        size_t average = done.characters / done.sentences + 1;
+        return std::clamp<size_t>((limit - out.size()) / (2 * average), 1, Config::SENTENCE_BATCH);
+    });
+}
+
+/**
+ * Generates the text for @p opts into @p writer and finishes it; the body of both
+ * generate_text() overloads.
+ **/
+void generateInto(OutputWriter &writer, const Options& opts, const WordTable& table,
+                  const WeightedIndex* weighted, const MarkovModel* model) {
+    writer.set_format(opts.format);
+    if (!opts.weighted)
+        weighted = nullptr;
+
+    Random rng(opts.engine, opts.seed != 0 ? opts.seed : 1);
+
+    Mode mode = Mode::NORMAL;
+    if (opts.simple_mode)
+        mode = Mode::SIMPLE;
+    else if (opts.complex_mode)
+        mode = Mode::COMPLEX;
+
+    Grammar grammar(rng, mode, opts.skeleton_cache);
+    Lexicon lexicon(rng, table, weighted);
+
+    std::unique_ptr<TextSource> source;
+    if (model != nullptr) {
+        source = std::make_unique<MarkovSource>(*model, rng);
+    } else if (opts.parallel || opts.range_end != -1) {
+        unsigned int threads = opts.parallel ? opts.threads : 1;
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        uint64_t first = opts.range_end != -1 ? static_cast<uint64_t>(opts.range_begin) : 0;
+        source = std::make_unique<ParallelSource>(table, weighted, mode, opts.skeleton_cache, opts.engine,
+                                                  opts.seed != 0 ? opts.seed : 1, threads, first);
+    } else {
+        source = std::make_unique<SequentialSource>(grammar, lexicon, rng);
+    }
+
+    /* --range: paragraphs [begin, end) of the block-seeded stream, without the header */
+    if (opts.range_end != -1) {
+        Stats::ScopedTimer sizingTimer(Stats::Timer::SIZING);
+        streamParagraphsUntil(writer, 0, static_cast<size_t>(opts.range_end - opts.range_begin),
+                              "\n\n", *source);
+        sizingTimer.stop();
+        writer.finish();
+        return;
+    }
+
+    const Sizing last = lastSizing(opts);
+
+    Stats::ScopedTimer sizingTimer(Stats::Timer::SIZING);
+    std::string output;
+    if (!opts.no_header) {
+        output = LOREM_IPSUM;
+    }
+
+    if (opts.paragraphs != -1) {
+        size_t headerParagraphs = count_paragraphs(output);
+        if ((int)headerParagraphs < opts.paragraphs) {
+            std::string separator = "\n\n";
+            if (last == Sizing::PARAGRAPHS) {
+                writer.write(output);
+                output.clear();
+                streamParagraphsUntil(writer, headerParagraphs, opts.paragraphs, separator, *source);
+            } else {
+                output = appendParagraphsUntil(output, headerParagraphs, opts.paragraphs, separator, *source);
+            }
+        } else if ((int)headerParagraphs > opts.paragraphs) {
+            std::istringstream iss(output);
+            std::ostringstream oss;
+            std::string line;
+            int count = 0;
+            while (std::getline(iss, line) && count < opts.paragraphs) {
+                if (!trim(line).empty()) {
+                    if (count > 0)
+                        oss << (opts.no_paragraph ? " " : "\n");
+                    oss << trim(line);
+                    count++;
+                }
+            }
+            output = oss.str();
+        }
+    }
+
+    if (opts.sentences != -1) {
+        int currentSentences = count_sentences(output);
+        if (currentSentences > opts.sentences) {
+            std::istringstream iss(output);
+            std::ostringstream oss;
+            std::string line;
+            int sentencesCounted = 0;
+            while (std::getline(iss, line)) {
+                for (char ch : line) {
+                    oss << ch;
+                    if (ch == '.') {
+                        sentencesCounted++;
+                        if (sentencesCounted >= opts.sentences)
+                            break;
+                    }
+                }
+                if (sentencesCounted >= opts.sentences)
+                    break;
+                if (!opts.no_paragraph)
+                    oss << "\n";
+            }
+            output = oss.str();
+        } else if (currentSentences < opts.sentences) {
+            int extra_needed = opts.sentences - currentSentences;
+            if (last == Sizing::SENTENCES) {
+                if (!output.empty()) {
+                    output += opts.no_paragraph ? " " : "\n\n";
+                }
+                writer.write(output);
+                output.clear();
+                TextStats extra;
+                streamSentences(writer, *source, extra, [&](const TextStats &done) {
+                    return sentenceBatch(done.sentences, extra_needed);
+                });
+            } else {
+                std::string extra_sentences;
+                TextStats extra;
+                for (size_t count; (count = sentenceBatch(extra.sentences, extra_needed)) > 0;)
+                    source->generate_sentences(count, extra_sentences, extra);
+                if (!output.empty()) {
+                    output += opts.no_paragraph ? " " : "\n\n";
+                }
+                output += extra_sentences;
+            }
+        }
+    }
+
+    if (opts.words != -1) {
+        int currentWords = count_words(output);
+        if (currentWords > opts.words) {
+            std::istringstream iss(output);
+            std::ostringstream oss;
+            std::string word;
+            int count = 0;
+            while (iss >> word && count < opts.words) {
+                if (count > 0) oss << " ";
+                oss << word;
+                count++;
+            }
+            output = oss.str();
+        } else if (currentWords < opts.words && last == Sizing::WORDS) {
+            writer.write(output);
+            output.clear();
+            TextStats total;
+            total.words = currentWords;
+            streamSentences(writer, *source, total, [&](const TextStats &done) {
+                return wordBatch(done.words, opts.words, source->max_sentence_words());
+            });
+        } else if (currentWords < opts.words) {
+            TextStats total;
+            total.words = currentWords;
+            for (size_t count; (count = wordBatch(total.words, opts.words, source->max_sentence_words())) > 0;)
+                source->generate_sentences(count, output, total);
+        }
+    }
+
+    /* -c and -b always come last, so they stream directly into the capped writer. */
+    if (opts.characters != -1) {
+        fillToSize(writer, output, opts.characters, *source);
+        output.clear();
+    }
+
+    if (opts.byte_exclusive) {
+        fillToSize(writer, output, opts.bytes, *source);
+        output.clear();
+    }
+
+    if (opts.no_header && output.empty() &&
+        opts.paragraphs == -1 && opts.sentences == -1 &&
+        opts.words == -1 && opts.characters == -1 && !opts.byte_exclusive) {
+            TextStats stats;
+            output = std::string(source->next_paragraph(stats));
+    }
+
+    sizingTimer.stop();
+
+    writer.write(output);
+    writer.finish();
+}
+
+} /* namespace */
+
+void generate_text(const Options& opts, const WordTable& table, const WeightedIndex* weighted,
+                   std::ostream& out, const MarkovModel* model) {
+    OutputWriter writer(out, !opts.no_paragraph);
+    generateInto(writer, opts, table, weighted, model);
+}
+
+void generate_text(const Options& opts, const WordTable& table, const WeightedIndex* weighted,
+                   OutputWriter& writer, const MarkovModel* model) {
+    generateInto(writer, opts, table, weighted, model);
+}
+
+void generate_text(const Options& opts, const WordTable& table, const WeightedIndex* weighted, int fd,
+                   const MarkovModel* model) {
+    AsyncSink sink(fd, opts.vmsplice);
+    OutputWriter writer(sink, !opts.no_paragraph);
+    generateInto(writer, opts, table, weighted, model);
+}
@@ -0,0 +1,36 @@
+#ifndef GENERATE_HPP
+#define GENERATE_HPP
+
+#include "alias.hpp"
+#include "markov.hpp"
+#include "options.hpp"
+#include "output.hpp"
+#include "wordtable.hpp"
+#include <ostream>
+
+/**
+ * Generates the text described by @p opts (header, sizing flags, mode, seed, engine) from
+ * @p table and writes it, normalized and newline-terminated, to @p out. @p weighted must
+ * be built from @p table; it is required when opts.weighted is set and ignored otherwise.
+ * With a @p model, the sentences come from it instead of the grammar and @p table.
+ * Throws std::system_error as soon as @p out fails, without generating the rest.
+ **/
+void generate_text(const Options& opts, const WordTable& table, const WeightedIndex* weighted,
+                   std::ostream& out, const MarkovModel* model = nullptr);
+
+/**
+ * generate_text() through @p writer, which must be new or reset() so that its buffer can
+ * be reused from one text to the next. Its paragraph setting is used instead of opts.
+ **/
+void generate_text(const Options& opts, const WordTable& table, const WeightedIndex* weighted,
+                   OutputWriter& writer, const MarkovModel* model = nullptr);
+
+/**
+ * generate_text() to the file descriptor @p fd, through an AsyncSink so that generation
+ * overlaps with writing; opts.vmsplice selects splicing when @p fd is a pipe. Throws
+ * std::system_error if writing fails.
+ **/
+void generate_text(const Options& opts, const WordTable& table, const WeightedIndex* weighted, int fd,
+                   const MarkovModel* model = nullptr);
+
+#endif
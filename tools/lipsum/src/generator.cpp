@@ -0,0 +1,144 @@
+#include "lipsum.hpp"
+#include "alias.hpp"
+#include "config.hpp"
+#include "dictfile.hpp"
+#include "dictionary.hpp"
+#include "grammar.hpp"
+#include "lexicon.hpp"
+#include "output.hpp"
+#include "random.hpp"
+#include "source.hpp"
+#include "types.hpp"
+#include "wordtable.hpp"
+#include <algorithm>
+#include <ostream>
+
+namespace Lipsum {
+
+namespace {
+
+/**
+ * Appends @p count sentences to @p out, which holds the caller's text up to @p start:
+ * sentences of a batch are separated from the ones before them, but not from that text.
+ **/
+void append_sentences(SequentialSource& source, size_t count, std::string& out, size_t start,
+                      TextStats& stats) {
+    while (count > 0 && out.size() == start) {
+        out += source.next_sentence(stats);
+        count--;
+    }
+    if (count > 0)
+        source.generate_sentences(count, out, stats);
+}
+
+/**
+ * Streams sentences through a writer capped at @p count bytes and appends its text to
+ * @p out: the same normalizing, word-cutting writer -b uses, so the bytes are the tool's.
+ **/
+void append_bytes(SequentialSource& source, size_t count, std::string& out) {
+    size_t start = out.size();
+    StringBuffer buffer(out);
+    std::ostream stream(&buffer);
+    OutputWriter writer(stream, true, std::min(count + 1, Config::OUTPUT_BUFFER_SIZE));
+    writer.set_limit(count);
+
+    /* Batches sized from the average sentence so far, as for -b, and each after a gap */
+    TextStats stats;
+    std::string batch;
+    while (!writer.full()) {
+        size_t sentences = 1;
+        if (stats.sentences > 0) {
+            size_t average = stats.characters / stats.sentences + 1;
+            sentences = std::clamp<size_t>((count - writer.size()) / (2 * average), 1, Config::SENTENCE_BATCH);
+        }
+        batch.clear();
+        source.generate_sentences(sentences, batch, stats);
+        writer.write(" ");
+        writer.write(batch);
+    }
+    writer.finish();
+    /* finish() ends the text with a newline, which the library leaves to the caller */
+    if (out.size() > start)
+        out.pop_back();
+}
+
+} /* namespace */
+
+struct Generator::Impl {
+    std::unique_ptr<MappedDictionary> mapped;
+    const WordTable*                  table = nullptr;
+    std::unique_ptr<WeightedIndex>    weighted;
+    GrammarNS::Mode                   mode = GrammarNS::Mode::NORMAL;
+    Random::Engine                    engine = Random::Engine::MT19937;
+    bool                              cached = false;
+};
+
+Generator::Generator(const Settings& settings) : m_impl(std::make_unique<Impl>()) {
+    if (!settings.dict_path.empty()) {
+        m_impl->mapped = std::make_unique<MappedDictionary>(settings.dict_path);
+        m_impl->table = &m_impl->mapped->table();
+    } else {
+        m_impl->table = &get_test_word_table();
+    }
+    if (settings.weighted)
+        m_impl->weighted = std::make_unique<WeightedIndex>(*m_impl->table);
+
+    if (settings.complexity == Complexity::SIMPLE)
+        m_impl->mode = GrammarNS::Mode::SIMPLE;
+    else if (settings.complexity == Complexity::COMPLEX)
+        m_impl->mode = GrammarNS::Mode::COMPLEX;
+    m_impl->cached = settings.skeleton_cache;
+    if (settings.engine == Engine::XOSHIRO256)
+        m_impl->engine = Random::Engine::XOSHIRO256;
+}
+
+Generator::~Generator() = default;
+
+Generator::Generator(Generator&&) noexcept = default;
+
+Generator& Generator::operator=(Generator&&) noexcept = default;
+
+/**
+ * Sets up the random state exactly like generate_text() does, so the text matches the
+ * tool's for the same seed.
+ **/
+void Generator::generate(Unit unit, size_t count, unsigned int seed, std::string& out) const {
+    if (count == 0)
+        return;
+
+    Random rng(m_impl->engine, seed != 0 ? seed : 1);
+    GrammarNS::Grammar grammar(rng, m_impl->mode, m_impl->cached);
+    Lexicon lexicon(rng, *m_impl->table, m_impl->weighted.get());
+    SequentialSource source(grammar, lexicon, rng);
+
+    const size_t start = out.size();
+    TextStats stats;
+    switch (unit) {
+    case Unit::PARAGRAPHS:
+        while (stats.paragraphs < count) {
+            std::string_view paragraph = source.next_paragraph(stats);
+            if (out.size() > start)
+                out += "\n\n";
+            out += paragraph;
+        }
+        break;
+    case Unit::SENTENCES:
+        while (stats.sentences < count) {
+            size_t batch = std::min(count - stats.sentences, Config::SENTENCE_BATCH);
+            append_sentences(source, batch, out, start, stats);
+        }
+        break;
+    case Unit::WORDS:
+        while (stats.words < count) {
+            size_t batch = std::clamp<size_t>((count - stats.words) / GrammarNS::MAX_SENTENCE_WORDS,
+                                              1, Config::SENTENCE_BATCH);
+            append_sentences(source, batch, out, start, stats);
+        }
+        break;
+    case Unit::BYTES:
+        append_bytes(source, count, out);
+        break;
+    }
+}
+
+} /* namespace Lipsum */
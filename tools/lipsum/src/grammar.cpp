@@ -1,9 +1,10 @@
 #include "grammar.hpp"
 #include "config.hpp"
+#include "skeleton.hpp"
+#include "stats.hpp"
 #include "types.hpp"
 #include <memory>
 #include <vector>
-#include <random>
 
 namespace GrammarNS {
 
@@ -24,11 +25,7 @@ public:
         : Node(Node::Type::SLOT), m_pos(part_of_speech), m_required_gender(gender) {}
 
     void flatten(std::vector<Token>& tokens) const override {
-        Token token;
-        token.type = TokenType::WORD;
-        token.pos = m_pos;
-        token.required_gender = m_required_gender;
-        tokens.push_back(token);
+        tokens.push_back(Token::word(m_pos, m_required_gender));
     }
 
 private:
@@ -38,36 +35,79 @@ private:
 
 class PunctuationNode : public Node {
 public:
-    explicit PunctuationNode(const std::string& text)
-        : Node(Node::Type::PUNCTUATION), m_text(text) {}
+    explicit PunctuationNode(Punct mark)
+        : Node(Node::Type::PUNCTUATION), m_mark(mark) {}
 
     void flatten(std::vector<Token>& tokens) const override {
-        Token token;
-        token.type = TokenType::PUNCTUATION;
-        token.text = m_text;
-        tokens.push_back(token);
+        tokens.push_back(Token::punctuation(m_mark));
     }
 
 private:
-    std::string m_text;
+    Punct m_mark;
 };
 
-Grammar::Grammar(std::mt19937& rng, Mode mode) : m_rng(rng), m_mode(mode) {}
+namespace {
+
+void emit_slot(std::vector<Token>& tokens, POS part_of_speech, char gender) {
+    tokens.push_back(Token::word(part_of_speech, gender));
+}
+
+void emit_punctuation(std::vector<Token>& tokens, Punct mark) {
+    tokens.push_back(Token::punctuation(mark));
+}
+
+} /* namespace */
+
+Grammar::Grammar(const Random& rng, Mode mode, bool cached)
+    : m_rng(rng), m_mode(mode),
+      m_adj_cumulative(cumulative_weights<3>({ Config::PROB_ZERO_ADJ, Config::PROB_ONE_ADJ,
+                                               Config::PROB_TWO_ADJ })),
+      m_cache(cached ? &SkeletonCache::get(mode) : nullptr) {}
 
 std::vector<Token> Grammar::generate_sentence_skeleton() {
-    auto sentence_node = generate_sentence();
     std::vector<Token> tokens;
-    sentence_node->flatten(tokens);
+    generate_sentence_skeleton(tokens);
     return tokens;
 }
 
+void Grammar::generate_sentence_skeleton(std::vector<Token>& tokens) {
+    Stats::ScopedTimer timer(Stats::Timer::GRAMMAR);
+    tokens.clear();
+    emit_sentence(tokens);
+    Stats::add(Stats::Counter::TOKENS, tokens.size());
+}
+
+void Grammar::generate_sentence_skeletons(size_t count, std::vector<Token>& tokens,
+                                          std::vector<size_t>& ends) {
+    Stats::ScopedTimer timer(Stats::Timer::GRAMMAR);
+    tokens.clear();
+    ends.clear();
+    for (size_t i = 0; i < count; i++) {
+        emit_sentence(tokens);
+        ends.push_back(tokens.size());
+    }
+    Stats::add(Stats::Counter::TOKENS, tokens.size());
+}
+
+std::unique_ptr<Node> Grammar::generate_sentence_tree() {
+    return generate_sentence();
+}
+
 bool Grammar::chance(double probability) {
-    std::uniform_real_distribution<double> dist(0.0, 1.0);
-    return dist(m_rng) < probability;
+    return m_rng.uniform() < probability;
+}
+
+char Grammar::pick_noun_gender() {
+    static const char genders[] = { 'm', 'f', 'n' };
+    return genders[m_rng.between(0, 2)];
 }
 
-std::unique_ptr<Node> Grammar::generate_punctuation(const std::string& punct) {
-    return std::make_unique<PunctuationNode>(punct);
+int Grammar::pick_adjective_count() {
+    return static_cast<int>(m_rng.discrete(m_adj_cumulative));
+}
+
+std::unique_ptr<Node> Grammar::generate_punctuation(Punct mark) {
+    return std::make_unique<PunctuationNode>(mark);
 }
 
 /**
@@ -77,14 +117,8 @@ std::unique_ptr<Node> Grammar::generate_punctuation(const std::string& punct) {
 std::unique_ptr<Node> Grammar::generate_NP() {
     auto np = std::make_unique<CompositeNode>(Node::Type::NP);
 
-    char genders[] = { 'm', 'f', 'n' };
-    std::uniform_int_distribution<int> gender_dist(0, 2);
-    char noun_gender = genders[gender_dist(m_rng)];
-
-    std::discrete_distribution<int> adj_dist({ Config::PROB_ZERO_ADJ,
-                                               Config::PROB_ONE_ADJ,
-                                               Config::PROB_TWO_ADJ });
-    int num_adjectives = adj_dist(m_rng);
+    char noun_gender = pick_noun_gender();
+    int num_adjectives = pick_adjective_count();
 
     for (int i = 0; i < num_adjectives; i++) {
          np->add_child(std::make_unique<SlotNode>(POS::ADJECTIVE, noun_gender));
@@ -156,29 +190,109 @@ std::unique_ptr<Node> Grammar::generate_sentence() {
 
     if (m_mode == Mode::SIMPLE) {
     } else if (m_mode == Mode::COMPLEX) {
-        sentence->add_child(generate_punctuation(","));
+        sentence->add_child(generate_punctuation(Punct::COMMA));
         sentence->add_child(std::make_unique<SlotNode>(POS::CONJUNCTION, 'x'));
         sentence->add_child(generate_clause());
-        sentence->add_child(generate_punctuation(","));
+        sentence->add_child(generate_punctuation(Punct::COMMA));
         sentence->add_child(std::make_unique<SlotNode>(POS::CONJUNCTION, 'x'));
         sentence->add_child(generate_clause());
     } else {
         if (chance(Config::PROB_SECOND_CLAUSE)) {
-            sentence->add_child(generate_punctuation(","));
+            sentence->add_child(generate_punctuation(Punct::COMMA));
             sentence->add_child(std::make_unique<SlotNode>(POS::CONJUNCTION, 'x'));
             sentence->add_child(generate_clause());
 
             if (chance(Config::PROB_THIRD_CLAUSE)) {
-                sentence->add_child(generate_punctuation(","));
+                sentence->add_child(generate_punctuation(Punct::COMMA));
                 sentence->add_child(std::make_unique<SlotNode>(POS::CONJUNCTION, 'x'));
                 sentence->add_child(generate_clause());
             }
         }
     }
 
-    sentence->add_child(generate_punctuation("."));
+    sentence->add_child(generate_punctuation(Punct::PERIOD));
 
     return sentence;
 }
 
+/*
+ * Flat emitters. These mirror the generate_* functions above one for one, drawing from
+ * the random engine in the same order, but append tokens straight to the caller's buffer.
+ */
+
+void Grammar::emit_NP(std::vector<Token>& tokens) {
+    char noun_gender = pick_noun_gender();
+    int num_adjectives = pick_adjective_count();
+
+    for (int i = 0; i < num_adjectives; i++) {
+        emit_slot(tokens, POS::ADJECTIVE, noun_gender);
+    }
+    emit_slot(tokens, POS::NOUN, noun_gender);
+}
+
+void Grammar::emit_VP(std::vector<Token>& tokens) {
+    emit_slot(tokens, POS::VERB, 'x');
+
+    if (m_mode == Mode::SIMPLE) {
+    } else if (m_mode == Mode::COMPLEX) {
+        emit_NP(tokens);
+    } else {
+        if (chance(Config::PROB_COMPLEX_VP)) {
+            emit_NP(tokens);
+        }
+    }
+}
+
+void Grammar::emit_PP(std::vector<Token>& tokens) {
+    emit_slot(tokens, POS::PREPOSITION, 'x');
+    emit_NP(tokens);
+}
+
+void Grammar::emit_clause(std::vector<Token>& tokens) {
+    emit_NP(tokens);
+    emit_VP(tokens);
+
+    if (m_mode == Mode::SIMPLE) {
+    } else if (m_mode == Mode::COMPLEX) {
+        emit_PP(tokens);
+    } else {
+        if (chance(Config::PROB_PP_INCLSION)) {
+            emit_PP(tokens);
+        }
+    }
+}
+
+void Grammar::emit_sentence(std::vector<Token>& tokens) {
+    if (m_cache != nullptr) {
+        m_cache->emit_sentence(m_rng, tokens);
+        return;
+    }
+
+    emit_clause(tokens);
+
+    if (m_mode == Mode::SIMPLE) {
+    } else if (m_mode == Mode::COMPLEX) {
+        emit_punctuation(tokens, Punct::COMMA);
+        emit_slot(tokens, POS::CONJUNCTION, 'x');
+        emit_clause(tokens);
+        emit_punctuation(tokens, Punct::COMMA);
+        emit_slot(tokens, POS::CONJUNCTION, 'x');
+        emit_clause(tokens);
+    } else {
+        if (chance(Config::PROB_SECOND_CLAUSE)) {
+            emit_punctuation(tokens, Punct::COMMA);
+            emit_slot(tokens, POS::CONJUNCTION, 'x');
+            emit_clause(tokens);
+
+            if (chance(Config::PROB_THIRD_CLAUSE)) {
+                emit_punctuation(tokens, Punct::COMMA);
+                emit_slot(tokens, POS::CONJUNCTION, 'x');
+                emit_clause(tokens);
+            }
+        }
+    }
+
+    emit_punctuation(tokens, Punct::PERIOD);
+}
+
 } /* namespace GrammarNS */
@@ -1,14 +1,24 @@
 #ifndef Grammar_HPP
 #define Grammar_HPP
 
+#include "random.hpp"
 #include "types.hpp"
+#include <array>
 #include <memory>
 #include <vector>
-#include <random>
 #include <string>
 
 namespace GrammarNS {
 
+/**
+ * Most words a sentence can hold: three clauses of NP (2 adjectives + noun), VP (verb +
+ * object NP) and PP (preposition + NP), i.e. 11 words each, plus two conjunctions.
+ */
+constexpr size_t MAX_SENTENCE_WORDS = 3 * 11 + 2;
+
+/* Most tokens in a sentence's skeleton: its words, plus two commas and the period */
+constexpr size_t MAX_SENTENCE_TOKENS = MAX_SENTENCE_WORDS + 2 + 1;
+
 /* Modes for sentence complexity */
 enum class Mode {
     SIMPLE,
@@ -54,6 +64,8 @@ protected:
     std::vector<std::unique_ptr<Node>> m_children;
 };
 
+class SkeletonCache;
+
 /**
 * @brief The Grammar class builds the sentence skeleton as a tree and flattens it.
 *
@@ -62,13 +74,41 @@ protected:
 */
 class Grammar {
 public:
-    explicit Grammar(std::mt19937& rng, Mode mode = Mode::NORMAL);
+    /**
+     * With @p cached, skeletons are sampled from the mode's SkeletonCache instead of being
+     * built choice by choice: same distribution, fewer draws, different text per seed.
+     **/
+    explicit Grammar(const Random& rng, Mode mode = Mode::NORMAL, bool cached = false);
 
     std::vector<Token> generate_sentence_skeleton();
 
+    /**
+     * Writes the flattened skeleton of the next sentence into @p tokens, replacing its
+     * contents. Tokens are emitted directly without building a tree, so reusing the same
+     * vector across calls generates sentences without any allocation.
+     */
+    void generate_sentence_skeleton(std::vector<Token>& tokens);
+
+    /**
+     * Writes the skeletons of the next @p count sentences back to back into @p tokens and
+     * the end offset of each into @p ends, replacing the contents of both. Makes the same
+     * draws as @p count calls of generate_sentence_skeleton().
+     */
+    void generate_sentence_skeletons(size_t count, std::vector<Token>& tokens,
+                                     std::vector<size_t>& ends);
+
+    /**
+     * Builds the next sentence as a Node tree, for callers that want to inspect its
+     * structure. Consumes the random engine exactly like generate_sentence_skeleton()
+     * does without the cache; the tree is always built from the grammar rules.
+     */
+    std::unique_ptr<Node> generate_sentence_tree();
+
 private:
-    std::mt19937 m_rng;
-    Mode         m_mode;
+    Random                m_rng;
+    Mode                  m_mode;
+    std::array<double, 3> m_adj_cumulative; /* P(<= k adjectives) for k = 0, 1, 2 */
+    const SkeletonCache*  m_cache;          /* Null unless sampling cached skeletons */
 
     std::unique_ptr<Node> generate_sentence();
     std::unique_ptr<Node> generate_clause();
@@ -76,9 +116,19 @@ private:
     std::unique_ptr<Node> generate_VP();
     std::unique_ptr<Node> generate_PP();
 
+    void emit_sentence(std::vector<Token>& tokens);
+    void emit_clause(std::vector<Token>& tokens);
+    void emit_NP(std::vector<Token>& tokens);
+    void emit_VP(std::vector<Token>& tokens);
+    void emit_PP(std::vector<Token>& tokens);
+
     bool chance(double probability);
 
-    std::unique_ptr<Node> generate_punctuation(const std::string& punct);
+    /* Draws the gender and adjective count of a noun phrase, shared by both generators */
+    char pick_noun_gender();
+    int  pick_adjective_count();
+
+    std::unique_ptr<Node> generate_punctuation(Punct mark);
 };
 
 } /* namespace GrammarNS */
@@ -7,6 +7,7 @@ This script scrapes the "Most Common Latin Words" webpage from:
 
 It extracts Latin words and their parts of speech, applies simple heuristics to guess
 gender for nouns and adjectives, and formats the results as C++ dictionary initializers.
+The page lists words by frequency, so each entry also carries a Zipfian weight of 1 / rank.
 The formatted output is written to a file "dict.txt".
 
 Usage:
@@ -48,7 +49,7 @@ def parse_latin_words(html_content: bytes) -> pd.DataFrame:
         html_content (bytes): The HTML content of the webpage.
 
     Returns:
-        pd.DataFrame: DataFrame containing 'word' and 'pos' columns.
+        pd.DataFrame: DataFrame containing 'word', 'pos' and 'rank' (1 = most common) columns.
 
     Raises:
         ValueError: If the expected ordered list is not found.
@@ -65,7 +66,7 @@ def parse_latin_words(html_content: bytes) -> pd.DataFrame:
         vocab_div = li.find("div", class_="vocab")
         if vocab_div:
             word_text = vocab_div.get_text(strip=True)
-            word_list.append({"word": word_text, "pos": pos})
+            word_list.append({"word": word_text, "pos": pos, "rank": len(word_list) + 1})
         else:
             print("Warning: No <div class='vocab'> found in one of the <li> elements.")
 
@@ -132,7 +133,7 @@ def format_dictionary_entries(df: pd.DataFrame) -> str:
     Iterates over each allowed part of speech and formats the words into a string.
 
     Args:
-        df (pd.DataFrame): DataFrame with columns 'word', 'pos', and 'gender'.
+        df (pd.DataFrame): DataFrame with columns 'word', 'pos', 'rank' and 'gender'.
 
     Returns:
         str: The formatted dictionary as a single string.
@@ -148,7 +149,8 @@ def format_dictionary_entries(df: pd.DataFrame) -> str:
         for _, row in group.iterrows():
             word = row['word']
             gender = row['gender']
-            output_lines.append(f'    {{"{word}", POS::{pos_upper}, \'{gender}\' }},')
+            weight = 1.0 / row['rank']
+            output_lines.append(f'    {{"{word}", POS::{pos_upper}, \'{gender}\', {weight:#.6g}f }},')
 
         output_lines.append("};\n")
 
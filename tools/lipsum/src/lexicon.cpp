@@ -1,90 +1,144 @@
 #include "lexicon.hpp"
+#include "stats.hpp"
 #include "types.hpp"
 #include <iostream>
-#include <sstream>
 #include <vector>
-#include <random>
 #include <algorithm>
 #include <cctype>
 
-Lexicon::Lexicon(std::mt19937& rng, const Dictionary& dict)
-    : m_rng(rng), m_dictionary(dict) {}
+namespace {
+
+/* Stands in for a word of a part of speech the dictionary has none of */
+constexpr std::string_view MISSING_WORD = "[fallback]";
+
+} /* namespace */
+
+Lexicon::Lexicon(Random& rng, const Dictionary& dict)
+    : m_rng(rng), m_owned(std::make_unique<IndexedDictionary>(dict)), m_table(m_owned->table()),
+      m_weighted(nullptr) {}
+
+Lexicon::Lexicon(Random& rng, const WordTable& table, const WeightedIndex* weighted)
+    : m_rng(rng), m_table(table), m_weighted(weighted) {}
 
 /**
  * Selects a random word from the dictionary for the given part of speech and gender.
  */
-Word Lexicon::select_word(POS part_of_speech, char required_gender) {
-    auto it = m_dictionary.find(part_of_speech);
-    if (it == m_dictionary.end() || it->second.empty()) {
-        Word fallback = {"[fallback]", part_of_speech, required_gender};
-        log_warning("selectWord", part_of_speech, required_gender, fallback);
-        return fallback;
+std::string_view Lexicon::select_word(POS part_of_speech, char required_gender) {
+    size_t slot = static_cast<size_t>(part_of_speech);
+    if (slot >= POS_COUNT || m_table.parts[slot].count == 0) {
+        log_warning("selectWord", part_of_speech, required_gender, MISSING_WORD);
+        return MISSING_WORD;
     }
 
-    const auto& words = it->second;
-    std::vector<Word> filtered;
+    const PosWords& words = m_table.parts[slot];
     if (required_gender != 'x') {
-        for (const auto& word : words) {
-            if (word.gender == required_gender) {
-                filtered.push_back(word);
-             }
+        for (size_t i = 0; i < words.gender_count; i++) {
+            const GenderSpan& gender = words.genders[i];
+            if (gender.gender == required_gender) {
+                if (m_weighted != nullptr)
+                    return gender.words[m_weighted->gender(part_of_speech, i).sample(m_rng)];
+                return gender.words[m_rng.below(gender.count)];
+            }
         }
-    } else {
-        filtered = words;
-    }
 
-    if (filtered.empty()) {
-        filtered = words;
-        std::uniform_int_distribution<size_t> dist(0, filtered.size() - 1);
-        Word fallback = filtered[dist(m_rng)];
+        std::string_view fallback = words.words[pick_in_part(part_of_speech, words.count)];
         log_warning("selectWord", part_of_speech, required_gender, fallback);
         return fallback;
     }
 
-    std::uniform_int_distribution<size_t> dist(0, filtered.size() - 1);
-    return filtered[dist(m_rng)];
+    return words.words[pick_in_part(part_of_speech, words.count)];
+}
+
+size_t Lexicon::pick_in_part(POS part_of_speech, size_t count) {
+    if (m_weighted != nullptr)
+        return m_weighted->part(part_of_speech).sample(m_rng);
+    return m_rng.below(count);
 }
 
 /**
  * Logs a warning message when a matching word is not found.
  **/
 void Lexicon::log_warning(const std::string& location, POS part_of_speech,
-                          char required_gender, const Word& fallback) {
+                          char required_gender, std::string_view fallback) {
+    Stats::add(Stats::Counter::FALLBACKS);
     std::cerr << "[Warning] In " << location << ": No word found for POS "
               << static_cast<int>(part_of_speech) << " with gender '" << required_gender
-              << "'. Using fallback word: \"" << fallback.text << "\"\n";
+              << "'. Using fallback word: \"" << fallback << "\"\n";
 }
 
 /**
  * Processes the flattened token list and produces the final sentence.
  **/
 std::string Lexicon::fillTokens(const std::vector<Token>& tokens) {
-    std::ostringstream oss;
-    bool need_space = false; /* Indicates if a space should be inserted before next token */
+    TextStats stats;
+    return fillTokens(tokens, stats);
+}
+
+std::string Lexicon::fillTokens(const std::vector<Token>& tokens, TextStats& stats) {
+    std::string sentence;
+    fillTokens(tokens, sentence, stats);
+    return sentence;
+}
+
+namespace {
+
+/**
+ * Uppercases the first letter in @p out from @p from on. Returns whether there was one.
+ **/
+bool capitalize_from(std::string& out, size_t from) {
+    for (size_t i = from; i < out.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(out[i]);
+        if (std::isalpha(c)) {
+            out[i] = static_cast<char>(std::toupper(c));
+            return true;
+        }
+    }
+    return false;
+}
+
+} /* namespace */
+
+/* Every token adds at most a word or punctuation mark and the space before it */
+size_t Lexicon::max_sentence_size(size_t tokens) const {
+    return tokens * (std::max(m_table.longest_word, MISSING_WORD.size()) + 1);
+}
 
-    for (const auto& token : tokens) {
+void Lexicon::fillTokens(const std::vector<Token>& tokens, std::string& out, TextStats& stats) {
+    fillTokens(tokens.data(), tokens.data() + tokens.size(), out, stats);
+}
+
+void Lexicon::fillTokens(const Token* first, const Token* last, std::string& out, TextStats& stats) {
+    Stats::ScopedTimer timer(Stats::Timer::LEXICON);
+    const size_t start = out.size();
+    bool need_space = false;  /* Indicates if a space should be inserted before next token */
+    bool capitalized = false; /* Whether the sentence's first letter has been written */
+
+    for (const Token* it = first; it != last; ++it) {
+        const Token& token = *it;
+        size_t before = out.size();
         if (token.type == TokenType::PUNCTUATION) {
-            oss << token.text;
+            std::string_view text = token.text();
+            if (out.size() == start && !text.empty())
+                stats.words++;
+            stats.sentences += std::count(text.begin(), text.end(), '.');
+            out += text;
             need_space = true;
         } else if (token.type == TokenType::WORD) {
-            if (need_space && oss.tellp() > 0) {
-                oss << " ";
+            if (need_space && out.size() > start) {
+                out += ' ';
             }
-            Word word = select_word(token.pos, token.required_gender);
-            oss << word.text;
+            std::string_view word = select_word(token.pos, token.required_gender);
+            if (!word.empty())
+                stats.words++;
+            out += word;
             need_space = true;
-         }
-    }
-
-    std::string sentence = oss.str();
-    if (!sentence.empty()) {
-        auto it = sentence.begin();
-        while (it != sentence.end() && !std::isalpha(static_cast<unsigned char>(*it))) {
-            it++;
-        }
-        if (it != sentence.end()) {
-            *it = static_cast<char>(std::toupper(*it));
         }
+        if (!capitalized)
+            capitalized = capitalize_from(out, before);
     }
-    return sentence;
+
+    size_t length = out.size() - start;
+    stats.characters += length;
+    Stats::add(Stats::Counter::SENTENCES);
+    Stats::add(Stats::Counter::BYTES, length);
 }
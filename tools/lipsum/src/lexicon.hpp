@@ -1,14 +1,25 @@
 #ifndef LEXICON_HPP
 #define LEXICON_HPP
 
+#include "alias.hpp"
+#include "random.hpp"
 #include "types.hpp"
-#include <random>
+#include "wordtable.hpp"
+#include <memory>
 #include <vector>
 #include <string>
+#include <string_view>
 
 class Lexicon {
 public:
-    Lexicon(std::mt19937& rng, const Dictionary& dict);
+    Lexicon(Random& rng, const Dictionary& dict);
+
+    /**
+     * Selects words straight from @p table, which must outlive the Lexicon. With
+     * @p weighted (built from the same table), words are drawn in proportion to their
+     * weights instead of uniformly.
+     **/
+    Lexicon(Random& rng, const WordTable& table, const WeightedIndex* weighted = nullptr);
 
     /**
      * This function processes the flattened token list and returns a completed sentance.
@@ -16,20 +27,44 @@ public:
      * */
     std::string fillTokens(const std::vector<Token>& tokens);
 
-private:
-    std::mt19937&     m_rng;
-    const Dictionary& m_dictionary;
+    /**
+     * Same as above, and also adds the sentence's word, sentence and character counts
+     * to @p stats so callers can keep running totals without re-scanning their output.
+     **/
+    std::string fillTokens(const std::vector<Token>& tokens, TextStats& stats);
+
+    /**
+     * Appends the sentence to @p out instead of returning it. Words are copied straight
+     * from the dictionary into the buffer and the first letter is capitalized as it is
+     * written, so reusing one buffer builds sentences without any temporary strings.
+     **/
+    void fillTokens(const std::vector<Token>& tokens, std::string& out, TextStats& stats);
+
+    /* Same as above for the skeleton in [@p first, @p last), e.g. one of a batch */
+    void fillTokens(const Token* first, const Token* last, std::string& out, TextStats& stats);
+
+    /* Most bytes fillTokens() appends for a skeleton of @p tokens tokens */
+    size_t max_sentence_size(size_t tokens) const;
 
     /**
      * Selects a random word from the dictionary for a given part of speech and gender.
      * If a word matching the criteria isn't found, a warning is logged and a fallback is used.*/
-    Word select_word(POS part_of_speech, char required_gender);
+    std::string_view select_word(POS part_of_speech, char required_gender);
+
+private:
+    Random&                            m_rng;
+    std::unique_ptr<IndexedDictionary> m_owned; /* Set when built from a Dictionary */
+    const WordTable&                   m_table;
+    const WeightedIndex*               m_weighted;
+
+    /* Index of a word drawn from the whole of @p part_of_speech */
+    size_t pick_in_part(POS part_of_speech, size_t count);
 
     /**
      * Logs a warning message when a word isn't found
      **/
     void log_warning(const std::string& location, POS part_of_speech, char required_gender,
-                     const Word& fallback);
+                     std::string_view fallback);
 };
 
 #endif
@@ -1,42 +1,23 @@
 #include <iostream>
-#include <sstream>
 #include <string>
-#include <random>
-#include <algorithm>
-#include <functional>
-#include <cstring>
+#include <chrono>
 #include <cstdlib>
-
-#include "grammar.hpp"
-#include "lexicon.hpp"
+#include <memory>
+#include <system_error>
+#include <vector>
+#include <unistd.h>
+
+#include "alias.hpp"
+#include "corpus.hpp"
+#include "dictfile.hpp"
 #include "dictionary.hpp"
-#include "types.hpp"
-
-using namespace std;
-using namespace GrammarNS;
-
-const std::string HELP_MESSAGE =
-    "Usage:\n"
-    "  lipsum [options]\n\n"
-    "Options:\n"
-    "  -h                  Print this help message.\n"
-    "  --seed <number>     Set the random seed for reproducibility.\n"
-    "  --simple            Force simple sentences (one clause, simple VP, no PP).\n"
-    "  --complex           Force complex sentences (max clauses, complex VP, always PP).\n"
-    "  --no-paragraph      Do not insert paragraph delimiters (output is one big block).\n"
-    "  --no-header         Do not include the original Lorem Ipsum text.\n"
-    "  --history           Display the history of Lorem Ipsum and exit.\n"
-    "  -p <number>         Ensure at least this many paragraphs (header counts as one if present).\n"
-    "  -s <number>         Ensure that this many additional sentences are produced.\n"
-    "  -w <number>         Ensure that this many additional words are produced.\n"
-    "  -c <number>         Ensure that this many additional characters are produced.\n"
-    "  -b <number>         (Exclusive) Final output is exactly this many bytes.\n";
-
-const std::string LOREM_IPSUM =
-    "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. "
-    "Ut enim ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea commodo consequat. "
-    "Duis aute irure dolor in reprehenderit in voluptate velit esse cillum dolore eu fugiat nulla pariatur. "
-    "Excepteur sint occaecat cupidatat non proident, sunt in culpa qui officia deserunt mollit anim id est laborum.";
+#include "generate.hpp"
+#include "markov.hpp"
+#include "options.hpp"
+#include "server.hpp"
+#include "skeleton.hpp"
+#include "stats.hpp"
+#include "wordtable.hpp"
 
 const std::string HISTORY_MESSAGE = R"(What is Lorem Ipsum?
 
@@ -52,216 +33,31 @@ It is a long established fact that a reader will be distracted by the readable c
 
 Source: https://www.lipsum.com/)";
 
-std::string trim(const std::string &str) {
-    const std::string whitespace = " \t\n\r";
-    size_t start = str.find_first_not_of(whitespace);
-    if (start == std::string::npos) return "";
-    size_t end = str.find_last_not_of(whitespace);
-    return str.substr(start, end - start + 1);
-}
-
-std::string normalize_line(const std::string& line) {
-    std::istringstream iss(line);
-    std::ostringstream oss;
-    std::string word;
-    bool first = true;
-    while (iss >> word) {
-        if (!first)
-            oss << " ";
-        oss << word;
-        first  = false;
-    }
-    return oss.str();
-}
-
-std::string normalize_with_paragraphs(const std::string& input) {
-    std::istringstream iss(input);
-    std::string line;
-    std::vector<std::string> lines;
-    while (std::getline(iss, line)) {
-        std::string normalized = normalize_line(line);
-        if (!normalized.empty())
-            lines.push_back(normalized);
-    }
-    std::ostringstream oss;
-    for (size_t i = 0; i < lines.size(); i++) {
-        if (i > 0)
-            oss << "\n\n";
-        oss << lines[i];
-    }
-    return oss.str();
-}
-
-std::string normalize_spaces(const std::string &str) {
-    std::istringstream iss(str);
-    std::ostringstream oss;
-    std::string word;
-    bool first = true;
-    while (iss >> word) {
-        if (!first) oss << " ";
-        oss << word;
-        first = false;
-    }
-    return oss.str();
-}
-
-size_t count_paragraphs(const std::string &text) {
-    std::istringstream iss(text);
-    std::string line;
-    size_t count = 0;
-    while (std::getline(iss, line)) {
-        if (!trim(line).empty())
-            count++;
-    }
-    return count;
-}
-
-size_t count_sentences(const std::string &text) {
-    return std::count(text.begin(), text.end(), '.');
-}
-
-size_t count_words(const std::string &text) {
-    std::istringstream iss(text);
-    size_t count = 0;
-    std::string word;
-    while (iss >> word)
-        count++;
-    return count;
-}
-
-struct Options {
-    bool show_help = false;
-    bool history = false;
-    bool no_header = false;
-    bool no_paragraph = false;
-    bool simple_mode = false;
-    bool complex_mode = false;
-    bool byte_exclusive = false;
-    bool debug_mode = false;
-    unsigned int seed = 0; // 0 means no seed provided; we can then use time(0) if needed.
-    int paragraphs = -1;
-    int sentences = -1;
-    int words = -1;
-    int characters = -1;
-    int bytes = -1;
-};
-
 Options parseArguments(int argc, char* argv[]) {
-    Options opts;
-    for (int i = 1; i < argc; ++i) {
-        std::string arg(argv[i]);
-        if (arg == "-h") {
-            opts.show_help = true;
-        } else if (arg == "--history") {
-            opts.history = true;
-        } else if (arg == "--seed") {
-            if (i + 1 < argc) {
-                opts.seed = std::stoul(argv[++i]);
-            } else {
-                std::cerr << "Error: --seed requires a number.\n";
-                exit(EXIT_FAILURE);
-            }
-        } else if (arg == "--simple") {
-            opts.simple_mode = true;
-        } else if (arg == "--complex") {
-            opts.complex_mode = true;
-        } else if (arg == "--no-paragraph") {
-            opts.no_paragraph = true;
-        } else if (arg == "--no-header") {
-            opts.no_header = true;
-        } else if (arg == "--debug") {
-            opts.debug_mode = true;
-        } else if (arg == "-p") {
-            if (i + 1 < argc) {
-                opts.paragraphs = std::stoi(argv[++i]);
-            } else {
-                std::cerr << "Error: -p requires a number.\n";
-                exit(EXIT_FAILURE);
-            }
-        } else if (arg == "-s") {
-            if (i + 1 < argc) {
-                opts.sentences = std::stoi(argv[++i]);
-            } else {
-                std::cerr << "Error: -s requires a number.\n";
-                exit(EXIT_FAILURE);
-            }
-        } else if (arg == "-w") {
-            if (i + 1 < argc) {
-                opts.words = std::stoi(argv[++i]);
-            } else {
-                std::cerr << "Error: -w requires a number.\n";
-                exit(EXIT_FAILURE);
-            }
-        } else if (arg == "-c") {
-            if (i + 1 < argc) {
-                opts.characters = std::stoi(argv[++i]);
-            } else {
-                std::cerr << "Error: -c requires a number.\n";
-                exit(EXIT_FAILURE);
-            }
-        } else if (arg == "-b") {
-            if (i + 1 < argc) {
-                opts.bytes = std::stoi(argv[++i]);
-                opts.byte_exclusive = true;
-            } else {
-                std::cerr << "Error: -b requires a number.\n";
-                exit(EXIT_FAILURE);
-            }
-        } else {
-            std::cerr << "Unknown option: " << arg << "\n";
+    try {
+        return parse_options(std::vector<std::string>(argv + 1, argv + argc));
+    } catch (const OptionError& e) {
+        std::cerr << e.what() << "\n";
+        if (e.show_help())
             std::cerr << HELP_MESSAGE;
-            exit(EXIT_FAILURE);
-        }
-    }
-    if (opts.byte_exclusive && (opts.paragraphs != -1 || opts.sentences != -1 || opts.words != -1 || opts.characters != -1)) {
-        std::cerr << "Error: -b flag is exclusive and cannot be used with -p, -s, -w, or -c.\n";
         exit(EXIT_FAILURE);
     }
-    if (opts.simple_mode && opts.complex_mode) {
-        std::cerr << "Error: --simple and --complex cannot be used together.\n";
-        exit(EXIT_FAILURE);
-    }
-    return opts;
 }
 
-std::string generateParagraph(GrammarNS::Grammar& grammar, Lexicon& lexicon, std::mt19937& rng) {
-    std::uniform_int_distribution<int> sentenceCountDist(4, 7);
-    int sentenceCount = sentenceCountDist(rng);
-    std::ostringstream paragraph;
-    for (int i = 0; i < sentenceCount; ++i) {
-        auto tokens = grammar.generate_sentence_skeleton();
-        std::string sentence = lexicon.fillTokens(tokens);
-        paragraph << sentence << " ";
-    }
-    return trim(paragraph.str());
-}
-
-std::string appendParagraphsUntil(const std::string &base, int targetCount,
-                                  std::function<int(const std::string&)> countFunc,
-                                  const std::string &separator,
-                                  GrammarNS::Grammar &grammar,
-                                  Lexicon &lexicon,
-                                  std::mt19937 &rng) {
-    std::string output = base;
-    while (countFunc(output) < targetCount) {
-        std::string paragraph = generateParagraph(grammar, lexicon, rng);
-        if (!output.empty())
-            output += separator;
-        output += paragraph;
+/**
+ * The arguments to forward with --client: everything except the --client option itself.
+ **/
+std::vector<std::string> clientRequest(int argc, char* argv[]) {
+    std::vector<std::string> request;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        if (arg == "--client") {
+            ++i;
+            continue;
+        }
+        request.push_back(arg);
     }
-    return output;
-}
-
-std::string trimToCharacters(const std::string &text, int targetChars) {
-    if ((int)text.size() <= targetChars)
-        return text;
-    return text.substr(0, targetChars);
-}
-
-std::string trimToBytes(const std::string &text, int targetBytes) {
-    if ((int)text.size() <= targetBytes)
-        return text;
-    return text.substr(0, targetBytes);
+    return request;
 }
 
 int main(int argc, char* argv[]) {
@@ -270,165 +66,92 @@ int main(int argc, char* argv[]) {
         std::cout << HELP_MESSAGE;
         return EXIT_SUCCESS;
     }
-    if (opts.paragraphs == 0) opts.paragraphs = -1;
-    if (opts.sentences == 0)  opts.sentences  = -1;
-    if (opts.words == 0)      opts.words      = -1;
-    if (opts.characters == 0) opts.characters = -1;
 
-    if (opts.history) {
-        std::cout << HISTORY_MESSAGE << std::endl;
+    if (opts.list_skeletons) {
+        GrammarNS::Mode mode = GrammarNS::Mode::NORMAL;
+        if (opts.simple_mode)
+            mode = GrammarNS::Mode::SIMPLE;
+        else if (opts.complex_mode)
+            mode = GrammarNS::Mode::COMPLEX;
+        GrammarNS::SkeletonCache::get(mode).describe(std::cout);
         return EXIT_SUCCESS;
     }
 
-    std::mt19937 rng;
-    if (opts.seed != 0) {
-        rng.seed(opts.seed);
-    } else {
-        rng.seed(1);
+    if (opts.history) {
+        std::cout << HISTORY_MESSAGE << std::endl;
+        return EXIT_SUCCESS;
     }
 
-    Mode mode = Mode::NORMAL;
-    if (opts.simple_mode)
-        mode = Mode::SIMPLE;
-    else if (opts.complex_mode)
-        mode = Mode::COMPLEX;
+    if (!opts.client_path.empty())
+        return run_client(opts.client_path, clientRequest(argc, argv));
 
-    Grammar grammar(rng, mode);
-    Dictionary dict = get_test_dictionary();
-    if (opts.debug_mode)
-        dict = get_debug_dictionary();
-
-    Lexicon lexicon(rng, dict);
-
-    std::string output;
-    if (!opts.no_header) {
-        output = LOREM_IPSUM;
+    auto start = std::chrono::steady_clock::now();
+    if (opts.stats) {
+#ifdef LIPSUM_STATS
+        Stats::enable();
+#else
+        std::cerr << "[Warning] --stats ignored: lipsum was built with STATS=0.\n";
+#endif
     }
 
-    if (opts.paragraphs != -1) {
-        size_t headerParagraphs = count_paragraphs(output);
-        if ((int)headerParagraphs < opts.paragraphs) {
-            std::string separator = "\n\n";
-            output = appendParagraphsUntil(output, opts.paragraphs, count_paragraphs, separator, grammar, lexicon, rng);
-        } else if ((int)headerParagraphs > opts.paragraphs) {
-            std::istringstream iss(output);
-            std::ostringstream oss;
-            std::string line;
-            int count = 0;
-            while (std::getline(iss, line) && count < opts.paragraphs) {
-                if (!trim(line).empty()) {
-                    if (count > 0)
-                        oss << (opts.no_paragraph ? " " : "\n");
-                    oss << trim(line);
-                    count++;
-                }
-            }
-            output = oss.str();
+    if (!opts.train_path.empty()) {
+        try {
+            train_markov_model(opts.train_path, opts.order, opts.save_model_path);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return EXIT_FAILURE;
         }
+        return EXIT_SUCCESS;
     }
 
-    if (opts.sentences != -1) {
-        int currentSentences = count_sentences(output);
-        if (currentSentences > opts.sentences) {
-            std::istringstream iss(output);
-            std::ostringstream oss;
-            std::string line;
-            int sentencesCounted = 0;
-            while (std::getline(iss, line)) {
-                for (char ch : line) {
-                    oss << ch;
-                    if (ch == '.') {
-                        sentencesCounted++;
-                        if (sentencesCounted >= opts.sentences)
-                            break;
-                    }
-                }
-                if (sentencesCounted >= opts.sentences)
-                    break;
-                if (!opts.no_paragraph)
-                    oss << "\n";
-            }
-            output = oss.str();
-        } else if (currentSentences < opts.sentences) {
-            int extra_needed = opts.sentences - currentSentences;
-            std::string extra_sentences;
-            while ((int)count_sentences(extra_sentences) < extra_needed) {
-                auto tokens = grammar.generate_sentence_skeleton();
-                std::string sentence = lexicon.fillTokens(tokens);
-                if (!extra_sentences.empty())
-                    extra_sentences += " ";
-                extra_sentences += sentence;
-            }
-            if (!output.empty()) {
-                output += opts.no_paragraph ? " " : "\n\n";
-            }
-            output += extra_sentences;
+    std::unique_ptr<MarkovModel> model;
+    if (!opts.model_path.empty()) {
+        try {
+            model = std::make_unique<MarkovModel>(opts.model_path);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return EXIT_FAILURE;
         }
     }
 
-    if (opts.words != -1) {
-        int currentWords = count_words(output);
-        if (currentWords > opts.words) {
-            std::istringstream iss(output);
-            std::ostringstream oss;
-            std::string word;
-            int count = 0;
-            while (iss >> word && count < opts.words) {
-                if (count > 0) oss << " ";
-                oss << word;
-                count++;
-            }
-            output = oss.str();
-        } else if (currentWords < opts.words) {
-            while (count_words(output) < (size_t)opts.words) {
-                auto tokens = grammar.generate_sentence_skeleton();
-                std::string sentence = lexicon.fillTokens(tokens);
-                output += " " + sentence;
-            }
+    std::unique_ptr<MappedDictionary> mapped;
+    const WordTable* table = nullptr;
+    if (!opts.dict_path.empty()) {
+        try {
+            mapped = std::make_unique<MappedDictionary>(opts.dict_path);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return EXIT_FAILURE;
         }
+        table = &mapped->table();
+    } else {
+        table = opts.debug_mode ? &get_debug_word_table() : &get_test_word_table();
     }
 
-    if (opts.characters != -1) {
-        if ((int)output.size() > opts.characters) {
-            output = trimToCharacters(output, opts.characters);
-        } else if ((int)output.size() < opts.characters) {
-            while ((int)output.size() < opts.characters) {
-                auto tokens = grammar.generate_sentence_skeleton();
-                std::string sentence = lexicon.fillTokens(tokens);
-                if (output.empty())
-                    output += sentence;
-                else
-                    output += " " + sentence;
-            }
-            output = trimToCharacters(output, opts.characters);
-        }
-    }
+    if (!opts.serve_path.empty())
+        return run_server(opts.serve_path, *table, opts.threads);
+
+    std::unique_ptr<WeightedIndex> weighted;
+    if (opts.weighted)
+        weighted = std::make_unique<WeightedIndex>(*table);
 
-    if (opts.byte_exclusive) {
-        if ((int)output.size() > opts.bytes) {
-            output = trimToBytes(output, opts.bytes);
-        } else if ((int)output.size() < opts.bytes) {
-            while ((int)output.size() < opts.bytes) {
-                auto tokens = grammar.generate_sentence_skeleton();
-                std::string sentence = lexicon.fillTokens(tokens);
-                output += " " + sentence;
-            }
-            output = trimToBytes(output, opts.bytes);
+    int status = EXIT_SUCCESS;
+    if (opts.docs > 0) {
+        status = run_corpus(opts, *table, weighted.get());
+    } else {
+        /* Nothing else goes to stdout during a run, so the writer thread can own the descriptor */
+        std::cout.flush();
+        try {
+            generate_text(opts, *table, weighted.get(), STDOUT_FILENO, model.get());
+        } catch (const std::system_error& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return EXIT_FAILURE;
         }
     }
 
-    if (opts.no_paragraph) {
-        std::replace(output.begin(), output.end(), '\n', ' ');
-        output = normalize_spaces(output);
-    } else
-        output = normalize_with_paragraphs(output);
-
-    if (opts.no_header && output.empty() &&
-        opts.paragraphs == -1 && opts.sentences == -1 &&
-        opts.words == -1 && opts.characters == -1 && !opts.byte_exclusive) {
-            output = generateParagraph(grammar, lexicon, rng);
+    if (Stats::enabled()) {
+        std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+        Stats::report(std::cerr, wall.count());
     }
-
-    std::cout << output << std::endl;
-    return EXIT_SUCCESS;
+    return status;
 }
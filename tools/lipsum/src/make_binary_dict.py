@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+"""
+make_binary_dict.py
+
+This script converts the dictionary written by latin_dict_scraper.py ("dict.txt", a list
+of C++ initializer entries) into the binary format that lipsum maps at startup with
+`--dict <file>`. The layout is documented in src/dictfile.hpp.
+
+Usage:
+    python make_binary_dict.py [dict.txt] [dict.bin]
+"""
+
+import math
+import re
+import struct
+import sys
+
+# Must match the order of `enum class POS` in src/types.hpp.
+POS_ORDER = ['NOUN', 'ADJECTIVE', 'VERB', 'ADVERB', 'PREPOSITION', 'CONJUNCTION']
+
+MAGIC = b'LIPSDICT'
+VERSION = 2
+
+HEADER_FORMAT = '<8sIIIIIIII'
+RUN_FORMAT = '<BcHII'
+ENTRY_FORMAT = '<II'
+WEIGHT_FORMAT = '<f'
+
+ENTRY_PATTERN = re.compile(
+    r'\{\s*"([^"]*)"\s*,\s*POS::(\w+)\s*,\s*\'(.)\'\s*(?:,\s*([0-9.eE+-]+)f?\s*)?\}')
+
+
+def parse_entries(text: str) -> list:
+    """
+    Extract (word, pos, gender, weight) tuples from C++ dictionary initializer text.
+
+    Entries without a weight (files from older scrapers) get 1 / rank, with rank being
+    the entry's position within its part of speech, like the built-in dictionary.
+
+    Args:
+        text (str): Contents of the scraper's output file.
+
+    Returns:
+        list: Tuples in file order.
+
+    Raises:
+        ValueError: If an entry names an unknown part of speech or has a negative or
+            non-finite weight.
+    """
+    entries = []
+    ranks = {}
+    for word, pos, gender, weight in ENTRY_PATTERN.findall(text):
+        if pos not in POS_ORDER:
+            raise ValueError(f"Unknown part of speech POS::{pos} for word '{word}'")
+        ranks[pos] = ranks.get(pos, 0) + 1
+        value = float(weight) if weight else 1.0 / ranks[pos]
+        if not math.isfinite(value) or value < 0:
+            raise ValueError(f"Weight {weight} for word '{word}' must be finite and non-negative")
+        entries.append((word, pos, gender, value))
+    return entries
+
+
+def build_binary(entries: list) -> bytes:
+    """
+    Group entries by part of speech and gender and lay them out in the binary format.
+
+    Words keep their file order within each (POS, gender) run, and genders are ordered
+    by first appearance within their POS.
+
+    Args:
+        entries (list): (word, pos, gender, weight) tuples.
+
+    Returns:
+        bytes: The complete dictionary file.
+    """
+    runs = []
+    for pos in POS_ORDER:
+        genders = []
+        for _, entry_pos, gender, _ in entries:
+            if entry_pos == pos and gender not in genders:
+                genders.append(gender)
+        for gender in genders:
+            words = [(w, wt) for w, p, g, wt in entries if p == pos and g == gender]
+            runs.append((POS_ORDER.index(pos), gender, words))
+
+    pool = bytearray()
+    offsets = {}
+    entry_bytes = bytearray()
+    weight_bytes = bytearray()
+    run_bytes = bytearray()
+    first = 0
+    for pos_index, gender, words in runs:
+        run_bytes += struct.pack(RUN_FORMAT, pos_index, gender.encode('ascii'), 0, first, len(words))
+        for word, weight in words:
+            encoded = word.encode('utf-8')
+            if encoded not in offsets:
+                offsets[encoded] = len(pool)
+                pool += encoded
+            entry_bytes += struct.pack(ENTRY_FORMAT, offsets[encoded], len(encoded))
+            weight_bytes += struct.pack(WEIGHT_FORMAT, weight)
+        first += len(words)
+
+    header_size = struct.calcsize(HEADER_FORMAT)
+    runs_offset = header_size
+    entries_offset = runs_offset + len(run_bytes)
+    weights_offset = entries_offset + len(entry_bytes)
+    pool_offset = weights_offset + len(weight_bytes)
+    header = struct.pack(HEADER_FORMAT, MAGIC, VERSION, len(runs), first, len(pool),
+                         runs_offset, entries_offset, pool_offset, weights_offset)
+    return header + bytes(run_bytes) + bytes(entry_bytes) + bytes(weight_bytes) + bytes(pool)
+
+
+def main():
+    """
+    Main function to convert 'dict.txt' (or argv[1]) into 'dict.bin' (or argv[2]).
+    """
+    input_filename = sys.argv[1] if len(sys.argv) > 1 else "dict.txt"
+    output_filename = sys.argv[2] if len(sys.argv) > 2 else "dict.bin"
+
+    try:
+        with open(input_filename, "r", encoding="utf-8") as f:
+            entries = parse_entries(f.read())
+    except (IOError, ValueError) as err:
+        print(f"Error reading {input_filename}: {err}")
+        return 1
+
+    data = build_binary(entries)
+    try:
+        with open(output_filename, "wb") as f:
+            f.write(data)
+        print(f"Wrote {len(entries)} words ({len(data)} bytes) to {output_filename}")
+    except IOError as io_err:
+        print(f"Error writing to file {output_filename}: {io_err}")
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
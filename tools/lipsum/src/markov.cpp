@@ -0,0 +1,381 @@
+#include "markov.hpp"
+#include "alias.hpp"
+#include "stats.hpp"
+#include "text.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+/* Bits per word of a packed context; three of them fit a uint64_t */
+constexpr unsigned int WORD_BITS = 21;
+constexpr uint32_t     MAX_WORD_ID = (1u << WORD_BITS) - 1;
+
+std::runtime_error format_error(const std::string& path, const std::string& what) {
+    return std::runtime_error("model file " + path + ": " + what);
+}
+
+bool section_fits(size_t file_size, uint64_t offset, uint64_t count, uint64_t width) {
+    return offset <= file_size && count * width <= file_size - offset;
+}
+
+bool is_space(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+}
+
+uint32_t align4(size_t offset) {
+    return static_cast<uint32_t>((offset + 3) & ~size_t(3));
+}
+
+/**
+ * @brief Count tables for training: the vocabulary, the states seen so far and every
+ * observed (state, next word) pair.
+ */
+class Counts {
+public:
+    explicit Counts(unsigned int order)
+        : m_mask((uint64_t(1) << (WORD_BITS * order)) - 1), m_words{ std::string_view() } {
+        state(0);
+    }
+
+    /* Adds the tokens of @p text */
+    void add_text(std::string_view text);
+
+    const std::vector<std::string_view>& words() const { return m_words; }
+    const std::vector<uint64_t>& contexts() const { return m_contexts; }
+
+    /* Each pair packed as state << 32 | word, one entry per occurrence */
+    std::vector<uint64_t>& pairs() { return m_pairs; }
+
+    /* The state reached by @p word from @p from, which must have been observed */
+    uint32_t successor(uint32_t from, uint32_t word) const {
+        return m_states.at(shift(m_contexts[from], word));
+    }
+
+private:
+    uint64_t                                    m_mask;
+    std::vector<std::string_view>               m_words;
+    std::unordered_map<std::string_view, uint32_t> m_ids;
+    std::vector<uint64_t>                       m_contexts; /* Context of each state */
+    std::unordered_map<uint64_t, uint32_t>      m_states;
+    std::vector<uint64_t>                       m_pairs;
+    uint64_t                                    m_context = 0;
+    bool                                        m_in_sentence = false;
+
+    uint64_t shift(uint64_t context, uint32_t word) const {
+        return ((context << WORD_BITS) | word) & m_mask;
+    }
+
+    uint32_t state(uint64_t context) {
+        auto [it, inserted] = m_states.try_emplace(context, static_cast<uint32_t>(m_contexts.size()));
+        if (inserted) {
+            if (m_contexts.size() == std::numeric_limits<uint32_t>::max())
+                throw std::runtime_error("too many distinct contexts for the model format");
+            m_contexts.push_back(context);
+        }
+        return it->second;
+    }
+
+    void observe(uint32_t word) {
+        m_pairs.push_back(uint64_t(state(m_context)) << 32 | word);
+        m_context = word != 0 ? shift(m_context, word) : 0;
+        m_in_sentence = word != 0;
+    }
+
+    void end_sentence() {
+        if (m_in_sentence)
+            observe(0);
+    }
+};
+
+void Counts::add_text(std::string_view text) {
+    size_t i = 0;
+    while (i < text.size()) {
+        int newlines = 0;
+        for (; i < text.size() && is_space(text[i]); i++)
+            newlines += text[i] == '\n';
+        if (newlines >= 2)
+            end_sentence();
+        if (i == text.size())
+            break;
+
+        size_t begin = i;
+        while (i < text.size() && !is_space(text[i]))
+            i++;
+        std::string_view token = text.substr(begin, i - begin);
+        auto [it, inserted] = m_ids.try_emplace(token, static_cast<uint32_t>(m_words.size()));
+        if (inserted) {
+            if (m_words.size() > MAX_WORD_ID)
+                throw std::runtime_error("more than " + std::to_string(MAX_WORD_ID) + " distinct words");
+            m_words.push_back(token);
+        }
+        observe(it->second);
+        if (ends_sentence(token))
+            end_sentence();
+    }
+    end_sentence();
+}
+
+template <typename T>
+void put(std::string& image, size_t offset, const T* data, size_t count) {
+    if (count > 0)
+        std::memcpy(&image[offset], data, count * sizeof(T));
+}
+
+} /* namespace */
+
+/**
+ * Sorting the pairs groups them by state and then by word, so each state's row and each
+ * transition's count fall out of one pass, and the rows come out in state order.
+ **/
+std::string build_markov_model(std::string_view text, unsigned int order) {
+    if (order < 1 || order > MARKOV_MAX_ORDER)
+        throw std::runtime_error("model order must be 1 to " + std::to_string(MARKOV_MAX_ORDER));
+    Counts counts(order);
+    counts.add_text(text);
+    std::vector<uint64_t>& pairs = counts.pairs();
+    if (pairs.empty())
+        throw std::runtime_error("no words to train on");
+    std::sort(pairs.begin(), pairs.end());
+
+    const size_t state_count = counts.contexts().size();
+    std::vector<uint32_t> rows(state_count + 1, 0);
+    std::vector<MarkovTransition> transitions;
+    std::vector<double> weights;
+    for (size_t i = 0; i < pairs.size();) {
+        const uint32_t from = static_cast<uint32_t>(pairs[i] >> 32);
+        const size_t row = transitions.size();
+        weights.clear();
+        while (i < pairs.size() && pairs[i] >> 32 == from) {
+            const uint64_t pair = pairs[i];
+            size_t end = i;
+            while (end < pairs.size() && pairs[end] == pair)
+                end++;
+            const uint32_t word = static_cast<uint32_t>(pair);
+            transitions.push_back({ word, word != 0 ? counts.successor(from, word) : 0, 0, 0 });
+            weights.push_back(static_cast<double>(end - i));
+            i = end;
+        }
+        if (transitions.size() > std::numeric_limits<uint32_t>::max())
+            throw std::runtime_error("too many transitions for the model format");
+
+        AliasTable table(weights.data(), weights.size());
+        for (size_t column = 0; column < weights.size(); column++) {
+            transitions[row + column].keep = table.keep(column);
+            transitions[row + column].alias = table.alias(column);
+        }
+        rows[from + 1] = static_cast<uint32_t>(transitions.size());
+    }
+    /* Every state has observed successors, so no row is empty and rows[] is complete */
+
+    const std::vector<std::string_view>& words = counts.words();
+    std::vector<DictFileEntry> entries;
+    entries.reserve(words.size());
+    std::string pool;
+    for (std::string_view word : words) {
+        entries.push_back({ static_cast<uint32_t>(pool.size()), static_cast<uint32_t>(word.size()) });
+        pool += word;
+    }
+
+    MarkovFileHeader header;
+    std::memcpy(header.magic, MARKOV_FILE_MAGIC, sizeof(header.magic));
+    header.version = MARKOV_FILE_VERSION;
+    header.order = order;
+    header.word_count = static_cast<uint32_t>(words.size());
+    header.state_count = static_cast<uint32_t>(state_count);
+    header.transition_count = static_cast<uint32_t>(transitions.size());
+    const uint64_t size = uint64_t(sizeof(header)) + rows.size() * sizeof(uint32_t) +
+                          transitions.size() * sizeof(MarkovTransition) +
+                          entries.size() * sizeof(DictFileEntry) + pool.size() + 12;
+    if (size > std::numeric_limits<uint32_t>::max())
+        throw std::runtime_error("model would exceed the 4 GB the format can address");
+    header.pool_size = static_cast<uint32_t>(pool.size());
+    header.rows_offset = align4(sizeof(header));
+    header.transitions_offset = align4(header.rows_offset + rows.size() * sizeof(uint32_t));
+    header.words_offset = align4(header.transitions_offset + transitions.size() * sizeof(MarkovTransition));
+    header.pool_offset = align4(header.words_offset + entries.size() * sizeof(DictFileEntry));
+
+    std::string image(header.pool_offset + pool.size(), '\0');
+    put(image, 0, &header, 1);
+    put(image, header.rows_offset, rows.data(), rows.size());
+    put(image, header.transitions_offset, transitions.data(), transitions.size());
+    put(image, header.words_offset, entries.data(), entries.size());
+    put(image, header.pool_offset, pool.data(), pool.size());
+    return image;
+}
+
+void train_markov_model(const std::string& text_path, unsigned int order, const std::string& model_path) {
+    std::ifstream in(text_path, std::ios::binary);
+    if (!in)
+        throw std::runtime_error("training text " + text_path + ": " + std::strerror(errno));
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (in.bad())
+        throw std::runtime_error("training text " + text_path + ": read failed");
+
+    std::string image = build_markov_model(text, order);
+    std::ofstream out(model_path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        throw format_error(model_path, std::strerror(errno));
+    out.write(image.data(), static_cast<std::streamsize>(image.size()));
+    out.close();
+    if (!out)
+        throw format_error(model_path, "write failed");
+}
+
+MarkovModel::MarkovModel(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw format_error(path, std::strerror(errno));
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        int err = errno;
+        ::close(fd);
+        throw format_error(path, std::strerror(err));
+    }
+    m_size = static_cast<size_t>(info.st_size);
+    if (m_size < sizeof(MarkovFileHeader)) {
+        ::close(fd);
+        throw format_error(path, "too small to be a model");
+    }
+
+    m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (m_data == MAP_FAILED) {
+        m_data = nullptr;
+        throw format_error(path, std::strerror(errno));
+    }
+
+    try {
+        index(path);
+    } catch (...) {
+        ::munmap(m_data, m_size);
+        throw;
+    }
+}
+
+MarkovModel::~MarkovModel() {
+    if (m_data != nullptr)
+        ::munmap(m_data, m_size);
+}
+
+/**
+ * Validates the mapped file, so that generation can follow rows, aliases, successor
+ * states and words without checking them.
+ **/
+void MarkovModel::index(const std::string& path) {
+    const char* base = static_cast<const char*>(m_data);
+    const auto* header = reinterpret_cast<const MarkovFileHeader*>(base);
+
+    if (std::memcmp(header->magic, MARKOV_FILE_MAGIC, sizeof(MARKOV_FILE_MAGIC)) != 0)
+        throw format_error(path, "not a lipsum model");
+    if (header->version != MARKOV_FILE_VERSION)
+        throw format_error(path, "unsupported version " + std::to_string(header->version));
+    if (header->order < 1 || header->order > MARKOV_MAX_ORDER || header->state_count == 0 ||
+        header->word_count == 0)
+        throw format_error(path, "bad header");
+    if (!section_fits(m_size, header->rows_offset, uint64_t(header->state_count) + 1, sizeof(uint32_t)) ||
+        !section_fits(m_size, header->transitions_offset, header->transition_count, sizeof(MarkovTransition)) ||
+        !section_fits(m_size, header->words_offset, header->word_count, sizeof(DictFileEntry)) ||
+        !section_fits(m_size, header->pool_offset, header->pool_size, 1) ||
+        header->rows_offset % alignof(uint32_t) != 0 ||
+        header->transitions_offset % alignof(MarkovTransition) != 0 ||
+        header->words_offset % alignof(DictFileEntry) != 0)
+        throw format_error(path, "section out of bounds");
+
+    const auto* rows = reinterpret_cast<const uint32_t*>(base + header->rows_offset);
+    const auto* transitions = reinterpret_cast<const MarkovTransition*>(base + header->transitions_offset);
+    const auto* words = reinterpret_cast<const DictFileEntry*>(base + header->words_offset);
+
+    for (uint32_t i = 0; i < header->word_count; i++) {
+        if (words[i].offset > header->pool_size || words[i].length > header->pool_size - words[i].offset)
+            throw format_error(path, "word " + std::to_string(i) + " out of bounds");
+    }
+
+    if (rows[0] != 0 || rows[header->state_count] != header->transition_count)
+        throw format_error(path, "rows do not cover every transition");
+    for (uint32_t state = 0; state < header->state_count; state++) {
+        const uint32_t first = rows[state];
+        const uint32_t last = rows[state + 1];
+        if (last <= first || last > header->transition_count)
+            throw format_error(path, "bad row " + std::to_string(state));
+        for (uint32_t i = first; i < last; i++) {
+            const MarkovTransition& transition = transitions[i];
+            if (transition.word >= header->word_count || transition.next_state >= header->state_count ||
+                transition.alias >= last - first)
+                throw format_error(path, "bad transition " + std::to_string(i));
+        }
+    }
+
+    m_header = header;
+    m_rows = rows;
+    m_transitions = transitions;
+    m_words = words;
+    m_pool = base + header->pool_offset;
+}
+
+void MarkovModel::append_sentence(Random& rng, std::string& text, TextStats& stats) const {
+    if (!text.empty())
+        text += ' ';
+    const size_t start = text.size();
+    std::string_view last;
+    size_t count = 0;
+    uint32_t state = 0;
+    while (count < Config::MARKOV_MAX_SENTENCE_WORDS) {
+        const MarkovTransition* row = m_transitions + m_rows[state];
+        const MarkovTransition& column = row[rng.below(m_rows[state + 1] - m_rows[state])];
+        const MarkovTransition& next = rng.bits() < column.keep ? column : row[column.alias];
+        if (next.word == 0)
+            break;
+        if (count > 0)
+            text += ' ';
+        last = word(next.word);
+        text += last;
+        count++;
+        state = next.next_state;
+    }
+    if (!ends_sentence(last))
+        text += '.';
+
+    const size_t length = text.size() - start;
+    stats.words += count;
+    stats.sentences++;
+    stats.characters += length;
+    Stats::add(Stats::Counter::SENTENCES);
+    Stats::add(Stats::Counter::BYTES, length);
+}
+
+MarkovSource::MarkovSource(const MarkovModel& model, Random& rng) : m_model(model), m_rng(rng) {}
+
+std::string_view MarkovSource::next_sentence(TextStats& stats) {
+    m_text.clear();
+    m_model.append_sentence(m_rng, m_text, stats);
+    return m_text;
+}
+
+std::string_view MarkovSource::next_paragraph(TextStats& stats) {
+    int sentenceCount = draw_paragraph_length(m_rng);
+    m_text.clear();
+    TextStats paragraphStats;
+    generate_sentences(static_cast<size_t>(sentenceCount), m_text, paragraphStats);
+    paragraphStats.paragraphs = m_text.empty() ? 0 : 1;
+    paragraphStats.characters = m_text.size();
+    stats += paragraphStats;
+    return m_text;
+}
+
+void MarkovSource::generate_sentences(size_t count, std::string& sink, TextStats& stats) {
+    for (size_t i = 0; i < count; i++)
+        m_model.append_sentence(m_rng, sink, stats);
+}
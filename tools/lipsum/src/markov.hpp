@@ -0,0 +1,144 @@
+#ifndef MARKOV_HPP
+#define MARKOV_HPP
+
+#include "config.hpp"
+#include "dictfile.hpp"
+#include "random.hpp"
+#include "source.hpp"
+#include "types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @file markov.hpp
+ * @brief Word-level Markov model trained from a text file (--train, --model).
+ *
+ * A state is the last `order` words of the sentence so far, padded at the start with the
+ * sentence boundary (word 0). Each state's successors, with their observed counts, are
+ * stored as an alias table, so drawing the next word costs two random numbers and two
+ * array reads whatever the vocabulary, and each transition also names the state it leads
+ * to, so generation never hashes or searches.
+ *
+ * Layout (little-endian, every section 4-byte aligned):
+ *
+ *   MarkovFileHeader
+ *   uint32_t         rows[state_count + 1]         transitions of state s are [rows[s], rows[s + 1])
+ *   MarkovTransition transitions[transition_count]
+ *   DictFileEntry    words[word_count]             word 0 is the sentence boundary, ""
+ *   char             pool[pool_size]               word bytes, not NUL-terminated
+ *
+ * State 0 is the start of a sentence, and a transition to word 0 ends the sentence.
+ */
+
+constexpr char     MARKOV_FILE_MAGIC[8] = { 'L', 'I', 'P', 'S', 'M', 'R', 'K', 'V' };
+constexpr uint32_t MARKOV_FILE_VERSION = 1;
+constexpr unsigned MARKOV_MAX_ORDER = 3;
+
+struct MarkovFileHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t order;
+    uint32_t word_count;
+    uint32_t state_count;
+    uint32_t transition_count;
+    uint32_t pool_size;
+    uint32_t rows_offset;
+    uint32_t transitions_offset;
+    uint32_t words_offset;
+    uint32_t pool_offset;
+};
+
+/* One column of a state's alias table: the column's own word, or the one at alias */
+struct MarkovTransition {
+    uint32_t word;
+    uint32_t next_state; /* State after this word; 0 for the boundary */
+    uint32_t keep;       /* Take this column rather than its alias if 32 random bits are below this */
+    uint32_t alias;      /* Index within the state's row */
+};
+
+static_assert(sizeof(MarkovFileHeader) == 48, "MarkovFileHeader must match the file layout");
+static_assert(sizeof(MarkovTransition) == 16, "MarkovTransition must match the file layout");
+
+/**
+ * Trains a model of @p order (1 to MARKOV_MAX_ORDER words of context) on @p text and
+ * returns it in the file format. Words are whitespace-separated tokens taken verbatim,
+ * punctuation included; a sentence ends after a token ending in '.', '!' or '?' (before
+ * any closing quotes or brackets) and at a blank line. Throws std::runtime_error if the
+ * text has no words or more distinct words or transitions than the format can hold.
+ **/
+std::string build_markov_model(std::string_view text, unsigned int order);
+
+/**
+ * Trains a model of @p order on the file @p text_path and writes it to @p model_path.
+ * Throws std::runtime_error.
+ **/
+void train_markov_model(const std::string& text_path, unsigned int order, const std::string& model_path);
+
+/**
+ * @brief A model file mapped read-only into memory.
+ *
+ * Loading checks the header and that every index in the file is in range, and does no
+ * other work. Throws std::runtime_error if the file can't be mapped or is malformed.
+ */
+class MarkovModel {
+public:
+    explicit MarkovModel(const std::string& path);
+
+    ~MarkovModel();
+
+    MarkovModel(const MarkovModel&) = delete;
+    MarkovModel& operator=(const MarkovModel&) = delete;
+
+    unsigned int order() const { return m_header->order; }
+    size_t word_count() const { return m_header->word_count; }
+    size_t state_count() const { return m_header->state_count; }
+    size_t transition_count() const { return m_header->transition_count; }
+
+    /**
+     * Appends one sentence drawn with @p rng to @p text, separated by a space from
+     * anything already there, and adds its counts to @p stats. A sentence is cut at
+     * Config::MARKOV_MAX_SENTENCE_WORDS words, and gets a period if its last word does
+     * not end a sentence.
+     **/
+    void append_sentence(Random& rng, std::string& text, TextStats& stats) const;
+
+private:
+    void*                   m_data = nullptr;
+    size_t                  m_size = 0;
+    const MarkovFileHeader* m_header = nullptr;
+    const uint32_t*         m_rows = nullptr;
+    const MarkovTransition* m_transitions = nullptr;
+    const DictFileEntry*    m_words = nullptr;
+    const char*             m_pool = nullptr;
+
+    void index(const std::string& path);
+
+    std::string_view word(uint32_t id) const {
+        return std::string_view(m_pool + m_words[id].offset, m_words[id].length);
+    }
+};
+
+/**
+ * @brief Sentences and paragraphs from a MarkovModel, for the usual sizing flags.
+ */
+class MarkovSource : public TextSource {
+public:
+    MarkovSource(const MarkovModel& model, Random& rng);
+
+    std::string_view next_sentence(TextStats& stats) override;
+
+    std::string_view next_paragraph(TextStats& stats) override;
+
+    void generate_sentences(size_t count, std::string& sink, TextStats& stats) override;
+
+    size_t max_sentence_words() const override { return Config::MARKOV_MAX_SENTENCE_WORDS; }
+
+private:
+    const MarkovModel& m_model;
+    Random&            m_rng;
+    std::string        m_text;
+};
+
+#endif
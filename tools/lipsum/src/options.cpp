@@ -0,0 +1,334 @@
+#include "options.hpp"
+#include "config.hpp"
+#include <algorithm>
+#include <thread>
+#include <type_traits>
+
+const std::string HELP_MESSAGE =
+    "Usage:\n"
+    "  lipsum [options]\n\n"
+    "Options:\n"
+    "  -h                  Print this help message.\n"
+    "  --seed <number>     Set the random seed for reproducibility.\n"
+    "  --simple            Force simple sentences (one clause, simple VP, no PP).\n"
+    "  --complex           Force complex sentences (max clauses, complex VP, always PP).\n"
+    "  --no-paragraph      Do not insert paragraph delimiters (output is one big block).\n"
+    "  --no-header         Do not include the original Lorem Ipsum text.\n"
+    "  --history           Display the history of Lorem Ipsum and exit.\n"
+    "  --weighted          Pick words in proportion to their frequency weights instead of\n"
+    "                      uniformly.\n"
+    "  --dict <file>       Use a binary dictionary (see make_binary_dict.py) instead of\n"
+    "                      the built-in one.\n"
+    "  --rng <engine>      Random engine: mt19937 (default) or xoshiro256 (faster, but\n"
+    "                      different text for the same seed).\n"
+    "  --skeleton-cache    Sample sentence structures from a precomputed table (same\n"
+    "                      distribution, faster, different text for the same seed).\n"
+    "  --skeletons         Print the sentence structures of the mode and their\n"
+    "                      probabilities, then exit.\n"
+    "  --format <format>   Output as text (default), html, markdown or json; markup counts\n"
+    "                      toward -b and -c.\n"
+    "  --vmsplice          When stdout is a pipe, splice the output into it instead of\n"
+    "                      copying (only for readers that read(2) the pipe; see README).\n"
+    "  --stats             Print timings and counters for the run to stderr.\n"
+    "  --serve <socket>    Run as a server on this Unix socket; each request line holds the\n"
+    "                      generation options of one run (see README).\n"
+    "  --client <socket>   Have the server on this socket generate the text.\n"
+    "  --threads <number>  Generate on this many threads (0 = all cores). Output depends only\n"
+    "                      on the seed, not on the thread count.\n"
+    "  -p <number>         Ensure at least this many paragraphs (header counts as one if present).\n"
+    "  -s <number>         Ensure that this many additional sentences are produced.\n"
+    "  -w <number>         Ensure that this many additional words are produced.\n"
+    "  -c <number>         Ensure that this many additional characters are produced.\n"
+    "  -b <number>         (Exclusive) Final output is exactly this many bytes.\n"
+    "  --range <K..M>      Print only paragraphs K to M-1 (counting from 0) of the --threads\n"
+    "                      text for the seed, without generating the ones before them.\n"
+    "  --docs <number>     Write this many documents, each seeded from --seed and its\n"
+    "                      number, into --out-dir, on --threads threads (default: all).\n"
+    "                      Sizes may be ranges, e.g. -w 100..1000, drawn per document.\n"
+    "  --out-dir <dir>     Directory for --docs: one file per document, plus manifest.tsv.\n"
+    "  --shard-size <n>    With --docs, pack documents into shard files of up to n bytes.\n"
+    "  --size-dist <dist>  How --docs draws sizes from ranges: uniform (default) or log.\n"
+    "  --train <file>      Train a Markov model on this text file, write it to --save-model\n"
+    "                      and exit.\n"
+    "  --save-model <file> Where --train writes the model.\n"
+    "  --order <number>    Words of context for --train, 1 to 3 (default 2).\n"
+    "  --model <file>      Generate sentences from a model made by --train instead of the\n"
+    "                      grammar and dictionary.\n";
+
+namespace {
+
+template <typename T>
+T parse_number(const std::string& flag, const std::string& value) {
+    try {
+        if constexpr (std::is_same_v<T, int>)
+            return std::stoi(value);
+        else if constexpr (std::is_same_v<T, long long>)
+            return std::stoll(value);
+        else
+            return std::stoul(value);
+    } catch (const std::logic_error&) {
+        throw OptionError("Error: " + flag + " requires a number.");
+    }
+}
+
+/**
+ * Parses @p value as a sizing flag's number or, for --docs, an inclusive "min..max"
+ * range. @p max is left alone for a plain number.
+ **/
+template <typename T>
+void parse_size(const std::string& flag, const std::string& value, T& min, T& max) {
+    size_t dots = value.find("..");
+    if (dots == std::string::npos) {
+        min = parse_number<T>(flag, value);
+        return;
+    }
+    min = parse_number<T>(flag, value.substr(0, dots));
+    max = parse_number<T>(flag, value.substr(dots + 2));
+    if (min < 1 || max < min)
+        throw OptionError("Error: " + flag + " range must be min..max with 1 <= min <= max.");
+}
+
+} /* namespace */
+
+Options parse_options(const std::vector<std::string>& args) {
+    Options opts;
+    for (size_t i = 0; i < args.size(); ++i) {
+        const std::string& arg = args[i];
+        if (arg == "-h") {
+            opts.show_help = true;
+        } else if (arg == "--history") {
+            opts.history = true;
+        } else if (arg == "--seed") {
+            if (i + 1 < args.size()) {
+                opts.seed = parse_number<unsigned long>(arg, args[++i]);
+            } else {
+                throw OptionError("Error: --seed requires a number.");
+            }
+        } else if (arg == "--simple") {
+            opts.simple_mode = true;
+        } else if (arg == "--complex") {
+            opts.complex_mode = true;
+        } else if (arg == "--no-paragraph") {
+            opts.no_paragraph = true;
+        } else if (arg == "--no-header") {
+            opts.no_header = true;
+        } else if (arg == "--debug") {
+            opts.debug_mode = true;
+        } else if (arg == "--rng") {
+            if (i + 1 < args.size()) {
+                std::string name(args[++i]);
+                if (!parse_engine(name, opts.engine)) {
+                    throw OptionError("Error: unknown --rng engine '" + name +
+                                      "' (use mt19937 or xoshiro256).");
+                }
+            } else {
+                throw OptionError("Error: --rng requires an engine name.");
+            }
+        } else if (arg == "--weighted") {
+            opts.weighted = true;
+        } else if (arg == "--skeleton-cache") {
+            opts.skeleton_cache = true;
+        } else if (arg == "--skeletons") {
+            opts.list_skeletons = true;
+        } else if (arg == "--format") {
+            if (i + 1 < args.size()) {
+                std::string name(args[++i]);
+                if (!parse_format(name, opts.format)) {
+                    throw OptionError("Error: unknown --format '" + name +
+                                      "' (use text, html, markdown or json).");
+                }
+            } else {
+                throw OptionError("Error: --format requires a format name.");
+            }
+        } else if (arg == "--vmsplice") {
+            opts.vmsplice = true;
+        } else if (arg == "--stats") {
+            opts.stats = true;
+        } else if (arg == "--dict") {
+            if (i + 1 < args.size()) {
+                opts.dict_path = args[++i];
+            } else {
+                throw OptionError("Error: --dict requires a file name.");
+            }
+        } else if (arg == "--serve") {
+            if (i + 1 < args.size()) {
+                opts.serve_path = args[++i];
+            } else {
+                throw OptionError("Error: --serve requires a socket path.");
+            }
+        } else if (arg == "--client") {
+            if (i + 1 < args.size()) {
+                opts.client_path = args[++i];
+            } else {
+                throw OptionError("Error: --client requires a socket path.");
+            }
+        } else if (arg == "--threads") {
+            if (i + 1 < args.size()) {
+                const std::string& value = args[++i];
+                if (value.find('-') != std::string::npos)
+                    throw OptionError("Error: --threads requires a number.");
+                /* The text is the same for any count, so one meant for a bigger machine is capped */
+                unsigned long most = std::max(1u, std::thread::hardware_concurrency()) *
+                                     Config::MAX_THREADS_PER_CORE;
+                opts.threads = static_cast<unsigned int>(
+                    std::min(parse_number<unsigned long>(arg, value), most));
+                opts.parallel = true;
+            } else {
+                throw OptionError("Error: --threads requires a number.");
+            }
+        } else if (arg == "-p") {
+            if (i + 1 < args.size()) {
+                parse_size(arg, args[++i], opts.paragraphs, opts.paragraphs_max);
+            } else {
+                throw OptionError("Error: -p requires a number.");
+            }
+        } else if (arg == "-s") {
+            if (i + 1 < args.size()) {
+                parse_size(arg, args[++i], opts.sentences, opts.sentences_max);
+            } else {
+                throw OptionError("Error: -s requires a number.");
+            }
+        } else if (arg == "-w") {
+            if (i + 1 < args.size()) {
+                parse_size(arg, args[++i], opts.words, opts.words_max);
+            } else {
+                throw OptionError("Error: -w requires a number.");
+            }
+        } else if (arg == "-c") {
+            if (i + 1 < args.size()) {
+                parse_size(arg, args[++i], opts.characters, opts.characters_max);
+            } else {
+                throw OptionError("Error: -c requires a number.");
+            }
+        } else if (arg == "-b") {
+            if (i + 1 < args.size()) {
+                parse_size(arg, args[++i], opts.bytes, opts.bytes_max);
+                opts.byte_exclusive = true;
+            } else {
+                throw OptionError("Error: -b requires a number.");
+            }
+        } else if (arg == "--range") {
+            if (i + 1 < args.size()) {
+                std::string value(args[++i]);
+                size_t dots = value.find("..");
+                if (dots == std::string::npos)
+                    throw OptionError("Error: --range must be K..M.");
+                opts.range_begin = parse_number<long long>(arg, value.substr(0, dots));
+                opts.range_end = parse_number<long long>(arg, value.substr(dots + 2));
+                if (opts.range_begin < 0 || opts.range_end <= opts.range_begin)
+                    throw OptionError("Error: --range must be K..M with 0 <= K < M.");
+            } else {
+                throw OptionError("Error: --range requires K..M.");
+            }
+        } else if (arg == "--docs") {
+            if (i + 1 < args.size()) {
+                opts.docs = parse_number<long long>(arg, args[++i]);
+            } else {
+                throw OptionError("Error: --docs requires a number.");
+            }
+        } else if (arg == "--out-dir") {
+            if (i + 1 < args.size()) {
+                opts.out_dir = args[++i];
+            } else {
+                throw OptionError("Error: --out-dir requires a directory.");
+            }
+        } else if (arg == "--shard-size") {
+            if (i + 1 < args.size()) {
+                opts.shard_size = parse_number<long long>(arg, args[++i]);
+            } else {
+                throw OptionError("Error: --shard-size requires a number.");
+            }
+        } else if (arg == "--size-dist") {
+            if (i + 1 < args.size()) {
+                std::string name(args[++i]);
+                if (name == "uniform") {
+                    opts.size_distribution = SizeDistribution::UNIFORM;
+                } else if (name == "log") {
+                    opts.size_distribution = SizeDistribution::LOG_UNIFORM;
+                } else {
+                    throw OptionError("Error: unknown --size-dist '" + name + "' (use uniform or log).");
+                }
+            } else {
+                throw OptionError("Error: --size-dist requires a distribution name.");
+            }
+        } else if (arg == "--train") {
+            if (i + 1 < args.size()) {
+                opts.train_path = args[++i];
+            } else {
+                throw OptionError("Error: --train requires a file name.");
+            }
+        } else if (arg == "--save-model") {
+            if (i + 1 < args.size()) {
+                opts.save_model_path = args[++i];
+            } else {
+                throw OptionError("Error: --save-model requires a file name.");
+            }
+        } else if (arg == "--order") {
+            if (i + 1 < args.size()) {
+                opts.order = parse_number<unsigned long>(arg, args[++i]);
+                opts.order_given = true;
+            } else {
+                throw OptionError("Error: --order requires a number.");
+            }
+        } else if (arg == "--model") {
+            if (i + 1 < args.size()) {
+                opts.model_path = args[++i];
+            } else {
+                throw OptionError("Error: --model requires a file name.");
+            }
+        } else {
+            throw OptionError("Unknown option: " + arg, true);
+        }
+    }
+    if (opts.byte_exclusive && (opts.paragraphs != -1 || opts.sentences != -1 || opts.words != -1 || opts.characters != -1)) {
+        throw OptionError("Error: -b flag is exclusive and cannot be used with -p, -s, -w, or -c.");
+    }
+    if (opts.simple_mode && opts.complex_mode) {
+        throw OptionError("Error: --simple and --complex cannot be used together.");
+    }
+    if (!opts.serve_path.empty() && !opts.client_path.empty()) {
+        throw OptionError("Error: --serve and --client cannot be used together.");
+    }
+    bool ranged = opts.paragraphs_max != -1 || opts.sentences_max != -1 || opts.words_max != -1 ||
+                  opts.characters_max != -1 || opts.bytes_max != -1;
+    if (opts.docs < 0 || (opts.docs > 0 && opts.out_dir.empty())) {
+        throw OptionError("Error: --docs requires a positive number and --out-dir.");
+    }
+    if (opts.docs == 0 && (ranged || !opts.out_dir.empty() || opts.shard_size != 0)) {
+        throw OptionError("Error: size ranges, --out-dir and --shard-size require --docs.");
+    }
+    if (opts.docs > 0 && (!opts.serve_path.empty() || !opts.client_path.empty())) {
+        throw OptionError("Error: --docs cannot be used with --serve or --client.");
+    }
+    if (opts.docs >= 0xFFFFFFFFLL) {
+        throw OptionError("Error: --docs must be below 4294967295, the number of distinct seeds.");
+    }
+    if (opts.shard_size < 0) {
+        throw OptionError("Error: --shard-size must be positive.");
+    }
+    if (opts.train_path.empty() != opts.save_model_path.empty()) {
+        throw OptionError("Error: --train and --save-model must be used together.");
+    }
+    if (opts.order_given && opts.train_path.empty()) {
+        throw OptionError("Error: --order requires --train.");
+    }
+    if (opts.order < 1 || opts.order > 3) {
+        throw OptionError("Error: --order must be 1, 2 or 3.");
+    }
+    if (!opts.model_path.empty() &&
+        (!opts.train_path.empty() || !opts.dict_path.empty() || opts.weighted || opts.simple_mode ||
+         opts.complex_mode || opts.skeleton_cache || opts.parallel || opts.range_end != -1 ||
+         opts.docs != 0 || !opts.serve_path.empty())) {
+        throw OptionError("Error: --model cannot be used with --train, --dict, --weighted, --simple, "
+                          "--complex, --skeleton-cache, --threads, --range, --docs or --serve.");
+    }
+    if (opts.paragraphs == 0) opts.paragraphs = -1;
+    if (opts.sentences == 0)  opts.sentences  = -1;
+    if (opts.words == 0)      opts.words      = -1;
+    if (opts.characters == 0) opts.characters = -1;
+    if (opts.range_end != -1 && (opts.paragraphs != -1 || opts.sentences != -1 || opts.words != -1 ||
+                                 opts.characters != -1 || opts.byte_exclusive || opts.docs != 0)) {
+        throw OptionError("Error: --range cannot be used with -p, -s, -w, -c, -b or --docs.");
+    }
+    return opts;
+}
@@ -0,0 +1,90 @@
+#ifndef OPTIONS_HPP
+#define OPTIONS_HPP
+
+#include "format.hpp"
+#include "random.hpp"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @file options.hpp
+ * @brief Command-line options, shared by the CLI and the --serve request parser.
+ */
+
+extern const std::string HELP_MESSAGE;
+
+/* How --docs draws a document's size from a -p/-s/-w/-c/-b range */
+enum class SizeDistribution {
+    UNIFORM,
+    LOG_UNIFORM
+};
+
+struct Options {
+    bool show_help = false;
+    bool history = false;
+    bool no_header = false;
+    bool no_paragraph = false;
+    bool simple_mode = false;
+    bool complex_mode = false;
+    bool byte_exclusive = false;
+    bool debug_mode = false;
+    bool parallel = false;
+    bool stats = false;
+    bool weighted = false;
+    bool skeleton_cache = false; // --skeleton-cache: sample whole clauses from SkeletonCache.
+    bool list_skeletons = false; // --skeletons: print the mode's clause distribution and exit.
+    bool vmsplice = false;       // --vmsplice: splice output pages into a stdout pipe.
+    Format format = Format::TEXT; // --format: markup around paragraphs and sentences.
+    unsigned int threads = 0; // 0 with --threads means one per hardware thread.
+    std::string dict_path;
+    std::string serve_path;  // --serve: run as a daemon on this Unix socket.
+    std::string client_path; // --client: forward the request to a daemon on this socket.
+    Random::Engine engine = Random::Engine::MT19937;
+    unsigned int seed = 0; // 0 means no seed provided; we can then use time(0) if needed.
+    int paragraphs = -1;
+    int sentences = -1;
+    int words = -1;
+    long long characters = -1;
+    long long bytes = -1;
+    /* Upper ends of sizing ranges ("-w 100..1000", --docs only); -1 for a fixed size */
+    int paragraphs_max = -1;
+    int sentences_max = -1;
+    int words_max = -1;
+    long long characters_max = -1;
+    long long bytes_max = -1;
+    long long range_begin = -1;  // --range K..M: paragraphs [K, M) of the --threads stream.
+    long long range_end = -1;
+    long long docs = 0;          // --docs: write this many documents into out_dir.
+    std::string out_dir;
+    long long shard_size = 0;    // --shard-size: pack documents into files of about this size.
+    SizeDistribution size_distribution = SizeDistribution::UNIFORM;
+    std::string train_path;      // --train: build a Markov model from this text and exit.
+    std::string save_model_path; // --save-model: where --train writes the model.
+    unsigned int order = 2;      // --order: words of context of the trained model.
+    bool order_given = false;
+    std::string model_path;      // --model: generate from this Markov model.
+};
+
+/**
+ * @brief A malformed option list. what() is the message to show the user.
+ */
+class OptionError : public std::runtime_error {
+public:
+    explicit OptionError(const std::string& message, bool show_help = false)
+        : std::runtime_error(message), m_show_help(show_help) {}
+
+    /* Whether the usage text should follow the message */
+    bool show_help() const { return m_show_help; }
+
+private:
+    bool m_show_help;
+};
+
+/**
+ * Parses @p args (without the program name). Sizing flags given as 0 come back as -1,
+ * i.e. not given. Throws OptionError.
+ **/
+Options parse_options(const std::vector<std::string>& args);
+
+#endif
@@ -0,0 +1,370 @@
+#include "output.hpp"
+#include "scan.hpp"
+#include "stats.hpp"
+#include "text.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <system_error>
+
+namespace {
+
+/* ends_sentence() deciding the common case, a word ending in a letter or a period, from its last byte */
+inline bool word_ends_sentence(const char* word, size_t size) {
+    char last = word[size - 1];
+    if (last == '.' || last == '!' || last == '?')
+        return true;
+    if (last == '"' || last == '\'' || last == ')' || last == ']')
+        return ends_sentence(std::string_view(word, size));
+    return false;
+}
+
+/* Whether @p word is all closing quotes and brackets, which end a sentence if what they follow did */
+inline bool only_closers(const char* word, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        if (word[i] != '"' && word[i] != '\'' && word[i] != ')' && word[i] != ']')
+            return false;
+    }
+    return true;
+}
+
+} /* namespace */
+
+OutputWriter::OutputWriter(std::ostream& out, bool keep_paragraphs, size_t buffer_size)
+    : m_out(&out), m_keep_paragraphs(keep_paragraphs),
+      m_owned(new char[buffer_size > 0 ? buffer_size : 1]), m_buffer(m_owned.get()),
+      m_capacity(buffer_size > 0 ? buffer_size : 1), m_limit(std::numeric_limits<size_t>::max()) {}
+
+OutputWriter::OutputWriter(AsyncSink& sink, bool keep_paragraphs)
+    : m_sink(&sink), m_keep_paragraphs(keep_paragraphs), m_buffer(sink.acquire()),
+      m_capacity(sink.buffer_size()), m_limit(std::numeric_limits<size_t>::max()) {}
+
+OutputWriter::~OutputWriter() {
+    try {
+        flush();
+    } catch (const std::system_error&) {
+        /* Only reported by a finish() that was reached */
+    }
+}
+
+void OutputWriter::reset() {
+    m_used = 0;
+    m_limit = std::numeric_limits<size_t>::max();
+    m_size = 0;
+    m_gap = Gap::NONE;
+    m_started = false;
+    m_markup = nullptr;
+    m_block = Block::NONE;
+    m_closing = 0;
+    m_paragraph = 0;
+    m_sentence_end = false;
+    m_space_end = 0;
+    m_closed = false;
+}
+
+/**
+ * Feeds raw text through the whitespace normalizer into the output buffer. Words are
+ * located with Scan::find_space() and copied as whole runs; only the gaps between them
+ * are looked at byte by byte.
+ **/
+void OutputWriter::write(const char* data, size_t length) {
+    if (full())
+        return;
+    Stats::ScopedTimer timer(Stats::Timer::NORMALIZATION);
+    if (m_markup) {
+        write_formatted(data, length);
+        return;
+    }
+
+    size_t i = 0;
+    while (i < length) {
+        size_t end = Scan::find_space(data, i, length);
+        if (end > i) {
+            /* A gap goes out only with a byte of the word after it, so the text never ends in one */
+            if (m_started && m_gap != Gap::NONE) {
+                size_t gap = m_gap == Gap::PARAGRAPH ? 2 : 1;
+                if (gap < m_limit - m_size) {
+                    if (m_gap == Gap::PARAGRAPH)
+                        put('\n');
+                    put(m_gap == Gap::PARAGRAPH ? '\n' : ' ');
+                    m_size += gap;
+                }
+            }
+            m_gap = Gap::NONE;
+            m_started = true;
+            if (!emit(data + i, end - i))
+                return;
+        }
+
+        bool newline = false;
+        i = Scan::find_word(data, end, length, newline);
+        if (i > end) {
+            if (newline && m_keep_paragraphs)
+                m_gap = Gap::PARAGRAPH;
+            else if (m_gap == Gap::NONE)
+                m_gap = Gap::SPACE;
+        }
+    }
+}
+
+/* Copies as much of a word as the limit allows; false once the limit is reached */
+bool OutputWriter::emit(const char* data, size_t length) {
+    bool fits = length < m_limit - m_size;
+    if (!fits)
+        length = m_limit - m_size;
+    m_size += length;
+    while (length > 0) {
+        if (m_used == m_capacity)
+            flush();
+        size_t chunk = std::min(length, m_capacity - m_used);
+        std::memcpy(m_buffer + m_used, data, chunk);
+        m_used += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+    return fits;
+}
+
+/**
+ * The normalizer of write() with markup in place of the gaps: begin_word() turns the gap
+ * before each word into the markup the layout calls for. Bytes that need escaping are rare,
+ * so the next one is found ahead with one vector scan, and most words, which follow a
+ * plain space and come before it, are copied without leaving the loop.
+ **/
+void OutputWriter::write_formatted(const char* data, size_t length) {
+    size_t special = Scan::find_any(data, 0, length, m_markup->specials);
+    size_t i = 0;
+    while (i < length) {
+        size_t end = Scan::find_space(data, i, length);
+        if (end > i) {
+            const char* word = data + i;
+            const size_t size = end - i;
+            if (m_started && m_gap == Gap::SPACE && !m_sentence_end && end <= special &&
+                size + 1 < m_limit - m_size - m_closing) {
+                m_gap = Gap::NONE;
+                m_sentence_end = word_ends_sentence(word, size);
+                put(' ');
+                m_size++;
+                emit(word, size);
+            } else {
+                /* The rest of a word the previous write() stopped in */
+                const bool continued = m_started && m_gap == Gap::NONE;
+                const bool ended = m_sentence_end;
+                if (!begin_word() || !emit_escaped(word, size))
+                    return;
+                if (continued && only_closers(word, size))
+                    m_sentence_end = ended;
+            }
+            if (end > special)
+                special = Scan::find_any(data, end, length, m_markup->specials);
+        }
+
+        bool newline = false;
+        i = Scan::find_word(data, end, length, newline);
+        if (i > end) {
+            if (newline && m_keep_paragraphs)
+                m_gap = Gap::PARAGRAPH;
+            else if (m_gap == Gap::NONE)
+                m_gap = Gap::SPACE;
+        }
+    }
+}
+
+bool OutputWriter::begin_word() {
+    const Markup& markup = *m_markup;
+    const Gap gap = m_gap;
+    m_gap = Gap::NONE;
+    if (!m_started) {
+        Block block = paragraph_block(0);
+        bool fits = transition({ markup.document_open, open(block) }, block);
+        m_started = true;
+        return fits;
+    }
+    if (gap == Gap::PARAGRAPH) {
+        Block block = paragraph_block(++m_paragraph);
+        return transition({ close(m_block), markup.block_separator, open(block) }, block);
+    }
+    if (gap == Gap::NONE)
+        return true;
+    if (!m_sentence_end) {
+        /* Most words: a space within the block */
+        if (m_limit - m_size <= m_closing) {
+            seal();
+            return false;
+        }
+        put(' ');
+        m_size++;
+        m_space_end = m_size;
+        return true;
+    }
+    switch (m_block) {
+    case Block::HEADING:
+        return transition({ markup.heading_close, markup.block_separator, markup.paragraph_open },
+                          Block::PARAGRAPH);
+    case Block::LIST:
+        return transition({ markup.list_item_separator }, Block::LIST);
+    default:
+        return transition({ markup.sentence_separator }, m_block);
+    }
+}
+
+bool OutputWriter::transition(std::initializer_list<std::string_view> parts, Block next) {
+    size_t length = closing_size(next);
+    for (std::string_view part : parts)
+        length += part.size();
+    if (length >= m_limit - m_size) {
+        seal();
+        return false;
+    }
+    for (std::string_view part : parts)
+        emit(part.data(), part.size());
+    if (m_used > 0 && m_buffer[m_used - 1] == ' ')
+        m_space_end = m_size;
+    m_block = next;
+    m_closing = closing_size(next);
+    return true;
+}
+
+/* Escapes are written whole or not at all */
+bool OutputWriter::emit_escaped(const char* data, size_t length) {
+    const size_t budget = m_limit - m_closing;
+    m_sentence_end = word_ends_sentence(data, length);
+    size_t run = 0;
+    for (size_t i = 0; i < length; i++) {
+        std::string_view escape = m_markup->escape(data[i]);
+        if (escape.empty())
+            continue;
+        if (!emit_within(budget, data + run, i - run))
+            return false;
+        if (escape.size() > budget - m_size) {
+            seal();
+            return false;
+        }
+        emit(escape.data(), escape.size());
+        run = i + 1;
+    }
+    return emit_within(budget, data + run, length - run);
+}
+
+/* Copies text up to @p budget bytes of output, cut before a UTF-8 sequence that doesn't fit */
+bool OutputWriter::emit_within(size_t budget, const char* data, size_t length) {
+    if (length <= budget - m_size) {
+        emit(data, length);
+        return true;
+    }
+    size_t cut = budget - m_size;
+    while (cut > 0 && (static_cast<unsigned char>(data[cut]) & 0xC0) == 0x80)
+        cut--;
+    emit(data, cut);
+    seal();
+    return false;
+}
+
+/* Whether @p word is all closing quotes and brackets, which end a sentence if what they follow did */
+inline bool only_closers(const char* word, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        if (word[i] != '"' && word[i] != '\'' && word[i] != ')' && word[i] != ']')
+            return false;
+    }
+    return true;
+}
+
+OutputWriter::Block OutputWriter::paragraph_block(size_t paragraph) const {
+    if (!m_markup->sections)
+        return Block::PARAGRAPH;
+    size_t position = paragraph % Config::FORMAT_SECTION_PARAGRAPHS;
+    if (position == 0)
+        return Block::HEADING;
+    if (position == Config::FORMAT_SECTION_PARAGRAPHS / 2)
+        return Block::LIST;
+    return Block::PARAGRAPH;
+}
+
+std::string_view OutputWriter::open(Block block) const {
+    switch (block) {
+    case Block::HEADING:   return m_markup->heading_open;
+    case Block::PARAGRAPH: return m_markup->paragraph_open;
+    case Block::LIST:      return m_markup->list_open;
+    default:               return std::string_view();
+    }
+}
+
+std::string_view OutputWriter::close(Block block) const {
+    switch (block) {
+    case Block::HEADING:   return m_markup->heading_close;
+    case Block::PARAGRAPH: return m_markup->paragraph_close;
+    case Block::LIST:      return m_markup->list_close;
+    default:               return std::string_view();
+    }
+}
+
+void OutputWriter::seal() {
+    /* The space is still in the buffer: nothing was emitted after it */
+    if (m_space_end == m_size && m_size > 0) {
+        m_used--;
+        m_size--;
+    }
+    if (!m_started) {
+        m_started = true;
+        emit(m_markup->document_open.data(), m_markup->document_open.size());
+    }
+    std::string_view block = close(m_block);
+    emit(block.data(), block.size());
+    m_block = Block::NONE;
+    while (m_size + m_markup->document_close.size() < m_limit) {
+        put('\n');
+        m_size++;
+    }
+    close_document();
+}
+
+void OutputWriter::close_document() {
+    if (!m_started) {
+        m_started = true;
+        emit(m_markup->document_open.data(), m_markup->document_open.size());
+    }
+    std::string_view block = close(m_block);
+    emit(block.data(), block.size());
+    emit(m_markup->document_close.data(), m_markup->document_close.size());
+    m_block = Block::NONE;
+    m_closed = true;
+}
+
+void OutputWriter::finish() {
+    if (m_markup && !m_closed)
+        close_document();
+    put('\n');
+    if (m_sink) {
+        /* The last buffer is handed over without taking another one back */
+        Stats::add(Stats::Counter::OUTPUT_BYTES, m_used);
+        m_sink->submit(m_buffer, m_used);
+        m_buffer = nullptr;
+        m_capacity = m_used = 0;
+        m_limit = m_size;
+        m_sink->finish();
+    } else {
+        flush();
+        if (!m_out->flush())
+            throw std::system_error(std::make_error_code(std::errc::io_error), "write failed");
+    }
+}
+
+/* With a sink, the filled buffer is traded for an empty one instead of copied */
+void OutputWriter::flush() {
+    if (m_used > 0) {
+        Stats::add(Stats::Counter::OUTPUT_BYTES, m_used);
+        if (m_sink) {
+            m_sink->submit(m_buffer, m_used);
+            m_buffer = m_sink->acquire();
+        } else {
+            m_out->write(m_buffer, static_cast<std::streamsize>(m_used));
+            if (!*m_out) {
+                /* Nothing more is written, so a caller that keeps going does no work */
+                m_used = 0;
+                m_limit = m_size;
+                throw std::system_error(std::make_error_code(std::errc::io_error), "write failed");
+            }
+        }
+        m_used = 0;
+    }
+}
@@ -0,0 +1,194 @@
+#ifndef OUTPUT_HPP
+#define OUTPUT_HPP
+
+#include "config.hpp"
+#include "format.hpp"
+#include "sink.hpp"
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Buffered writer that normalizes generated text on its way to the output stream.
+ *
+ * Raw text is fed in through write() in arbitrary pieces. Whitespace runs are collapsed
+ * as the bytes arrive, exactly like a whole-string normalization pass would: words are
+ * separated by a single space, and with paragraphs enabled, any gap containing a newline
+ * becomes a blank line. Normalized bytes collect in a fixed-size buffer that is flushed
+ * in large chunks, so memory use does not depend on the size of the output.
+ *
+ * Writing to an AsyncSink, the writer fills the sink's buffers in place and hands each
+ * one over whole when it is full, and the sink's thread writes it out while the next one
+ * fills. Writing to a stream, the write() or finish() whose flush finds the stream failed
+ * throws std::system_error, so generation stops when the reader has gone away.
+ *
+ * With a format other than TEXT, the same pass wraps the text in markup (see format.hpp):
+ * paragraph gaps become block boundaries, a word ending in '.', '!' or '?' ends a
+ * sentence, and each word is escaped as it is copied.
+ */
+class OutputWriter {
+public:
+    OutputWriter(std::ostream& out, bool keep_paragraphs,
+                 size_t buffer_size = Config::OUTPUT_BUFFER_SIZE);
+
+    OutputWriter(AsyncSink& sink, bool keep_paragraphs);
+
+    ~OutputWriter();
+
+    /**
+     * Starts a new output to the same stream after finish(), keeping the buffer: the
+     * limit and format are cleared as in a new writer. Only for a writer made with a stream.
+     **/
+    void reset();
+
+    /**
+     * Caps the number of normalized bytes produced, not counting the newline finish()
+     * adds. Output stops exactly at the cap, even in the middle of a word, and anything
+     * written after that is dropped. It never ends in whitespace: where only the gap
+     * before the next word would fit, the last bytes are taken from that word instead.
+     **/
+    void set_limit(size_t bytes) { m_limit = bytes; }
+
+    /**
+     * Wraps the output in @p format; call before the first write(). The limit counts the
+     * markup too. When the text reaches it, the open block is closed after the last
+     * bytes that fit (never after a space or a partial escape) and the rest of the limit
+     * is filled with newlines before the document's closing markup, so the output stays
+     * well-formed and ends exactly at the limit, unless the limit is too small for the
+     * empty document.
+     **/
+    void set_format(Format format) { m_markup = format != Format::TEXT ? &markup(format) : nullptr; }
+
+    /* Number of normalized bytes produced so far. */
+    size_t size() const { return m_size; }
+
+    bool full() const { return m_size >= m_limit; }
+
+    void write(std::string_view text) { write(text.data(), text.size()); }
+
+    void write(const char* data, size_t length);
+
+    /**
+     * Terminates the output with a newline and flushes everything to the stream, throwing
+     * std::system_error if it failed. With a sink, waits until it has all been written and throws std::system_error if a write
+     * failed.
+     **/
+    void finish();
+
+private:
+    enum class Gap {
+        NONE,
+        SPACE,
+        PARAGRAPH
+    };
+
+    /* The markup block the text is in */
+    enum class Block {
+        NONE,
+        HEADING,
+        PARAGRAPH,
+        LIST
+    };
+
+    std::ostream*           m_out = nullptr;
+    AsyncSink*              m_sink = nullptr;
+    bool                    m_keep_paragraphs;
+    std::unique_ptr<char[]> m_owned;  /* The buffer when writing to a stream */
+    char*                   m_buffer; /* Left uninitialized so short runs touch few pages */
+    size_t                  m_capacity;
+    size_t                  m_used = 0;
+    size_t                  m_limit;
+    size_t                  m_size = 0;
+    Gap                     m_gap = Gap::NONE;
+    bool                    m_started = false; /* Whether any word has been emitted yet */
+    const Markup*           m_markup = nullptr;  /* Null for plain text */
+    Block                   m_block = Block::NONE;
+    size_t                  m_closing = 0;       /* closing_size(m_block) */
+    size_t                  m_paragraph = 0;     /* Index of the current paragraph */
+    bool                    m_sentence_end = false; /* The last word ended a sentence */
+    size_t                  m_space_end = 0;     /* m_size after the last space before a word */
+    bool                    m_closed = false;    /* The document's closing markup is out */
+
+    void put(char c) {
+        if (m_used == m_capacity)
+            flush();
+        m_buffer[m_used++] = c;
+    }
+
+    /* put() within the limit; false once the limit is reached */
+    bool emit(char c) {
+        if (m_size >= m_limit)
+            return false;
+        put(c);
+        m_size++;
+        return true;
+    }
+
+    bool emit(const char* data, size_t length);
+
+    void write_formatted(const char* data, size_t length);
+
+    /* Emits the markup due before the next word; false once the document is closed */
+    bool begin_word();
+
+    /**
+     * Emits @p parts and enters @p next if they, @p next's closing markup and a byte of
+     * the next word fit within the limit; otherwise closes the document.
+     **/
+    bool transition(std::initializer_list<std::string_view> parts, Block next);
+
+    /* Emits a word escaped, up to what the closing markup leaves room for */
+    bool emit_escaped(const char* data, size_t length);
+
+    bool emit_within(size_t budget, const char* data, size_t length);
+
+    Block paragraph_block(size_t paragraph) const;
+    std::string_view open(Block block) const;
+    std::string_view close(Block block) const;
+
+    size_t closing_size(Block block) const {
+        return close(block).size() + m_markup->document_close.size();
+    }
+
+    /**
+     * Closes the document at the limit: takes back a space no word followed, closes the
+     * block and fills the bytes left with newlines before the document's closing markup.
+     **/
+    void seal();
+
+    void close_document();
+
+    void flush();
+};
+
+/**
+ * @brief Stream buffer that appends everything to a string, for an OutputWriter whose
+ * text is wanted in memory. target() points it at another string.
+ */
+class StringBuffer : public std::streambuf {
+public:
+    explicit StringBuffer(std::string& text) : m_text(&text) {}
+
+    void target(std::string& text) { m_text = &text; }
+
+protected:
+    std::streamsize xsputn(const char* data, std::streamsize length) override {
+        m_text->append(data, static_cast<size_t>(length));
+        return length;
+    }
+
+    int_type overflow(int_type c) override {
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+            *m_text += traits_type::to_char_type(c);
+        return traits_type::not_eof(c);
+    }
+
+private:
+    std::string* m_text;
+};
+
+#endif
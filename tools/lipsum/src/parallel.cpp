@@ -0,0 +1,145 @@
+#include "parallel.hpp"
+#include "config.hpp"
+#include "lexicon.hpp"
+#include <utility>
+
+ParallelSource::ParallelSource(const WordTable& table, const WeightedIndex* weighted,
+                               GrammarNS::Mode mode, bool cached, Random::Engine engine,
+                               unsigned int seed, unsigned int threads, uint64_t first_paragraph)
+    : m_table(table), m_weighted(weighted), m_mode(mode), m_cached(cached), m_engine(engine),
+      m_seed(seed), m_next_claim(first_paragraph / Config::PARALLEL_BLOCK_PARAGRAPHS),
+      m_next_consume(m_next_claim), m_skip(first_paragraph % Config::PARALLEL_BLOCK_PARAGRAPHS) {
+    if (threads == 0)
+        threads = 1;
+    m_slots.resize(static_cast<size_t>(threads) * Config::PARALLEL_BLOCKS_PER_THREAD);
+    m_workers.reserve(threads);
+    for (unsigned int i = 0; i < threads; i++) {
+        m_workers.emplace_back(&ParallelSource::worker, this);
+    }
+}
+
+ParallelSource::~ParallelSource() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_space.notify_all();
+    for (auto& thread : m_workers) {
+        thread.join();
+    }
+}
+
+void ParallelSource::seed_block(Random& rng, unsigned int seed, uint64_t block) {
+    rng.seed_stream(seed, block);
+}
+
+void ParallelSource::worker() {
+    Random rng(m_engine);
+    Lexicon lexicon(rng, m_table, m_weighted);
+    std::vector<Token> tokens;
+    tokens.reserve(GrammarNS::MAX_SENTENCE_TOKENS);
+    Block block;
+
+    while (true) {
+        uint64_t index;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_space.wait(lock, [this] {
+                return m_stop || m_next_claim < m_next_consume + m_slots.size();
+            });
+            if (m_stop)
+                return;
+            index = m_next_claim++;
+        }
+
+        generate_block(index, block, rng, lexicon, tokens);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            Slot& slot = m_slots[index % m_slots.size()];
+            std::swap(slot.data, block);
+            slot.block = index;
+            slot.ready = true;
+        }
+        m_ready.notify_all();
+    }
+}
+
+/**
+ * Generates one block the same way the sequential path builds paragraphs: the grammar
+ * works on a copy of the block engine and the lexicon and paragraph lengths share it.
+ **/
+void ParallelSource::generate_block(uint64_t index, Block& out, Random& rng,
+                                    Lexicon& lexicon, std::vector<Token>& tokens) {
+    seed_block(rng, m_seed, index);
+    GrammarNS::Grammar grammar(rng, m_mode, m_cached);
+
+    /* Worst case, so a block of long paragraphs never grows a buffer that is passed around */
+    const size_t sentences = Config::PARALLEL_BLOCK_PARAGRAPHS * MAX_PARAGRAPH_SENTENCES;
+    const size_t sentence = lexicon.max_sentence_size(GrammarNS::MAX_SENTENCE_TOKENS) + 1;
+    out.text.clear();
+    out.text.reserve(sentences * sentence);
+    out.sentences.clear();
+    out.sentences.reserve(sentences);
+    for (size_t p = 0; p < Config::PARALLEL_BLOCK_PARAGRAPHS; p++) {
+        int sentenceCount = draw_paragraph_length(rng);
+        for (int i = 0; i < sentenceCount; ++i) {
+            grammar.generate_sentence_skeleton(tokens);
+            Sentence sentence{};
+            if (i > 0)
+                out.text += ' ';
+            sentence.begin = out.text.size();
+            lexicon.fillTokens(tokens, out.text, sentence.stats);
+            sentence.end = out.text.size();
+            sentence.ends_paragraph = (i + 1 == sentenceCount);
+            out.sentences.push_back(sentence);
+        }
+    }
+}
+
+void ParallelSource::advance() {
+    if (m_position < m_current.sentences.size())
+        return;
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        Slot& slot = m_slots[m_next_consume % m_slots.size()];
+        m_ready.wait(lock, [&] { return slot.ready && slot.block == m_next_consume; });
+        std::swap(m_current, slot.data);
+        slot.ready = false;
+        m_next_consume++;
+    }
+    m_space.notify_all();
+    m_position = 0;
+    for (; m_skip > 0; m_skip--) {
+        while (!m_current.sentences[m_position++].ends_paragraph) {}
+    }
+}
+
+std::string_view ParallelSource::next_sentence(TextStats& stats) {
+    advance();
+    const Sentence& sentence = m_current.sentences[m_position++];
+    stats += sentence.stats;
+    return std::string_view(m_current.text).substr(sentence.begin, sentence.end - sentence.begin);
+}
+
+/**
+ * Returns the rest of the current paragraph, or the next whole one if the last
+ * paragraph was used up.
+ **/
+std::string_view ParallelSource::next_paragraph(TextStats& stats) {
+    advance();
+    size_t begin = m_current.sentences[m_position].begin;
+    TextStats paragraphStats;
+    while (true) {
+        const Sentence& sentence = m_current.sentences[m_position++];
+        paragraphStats += sentence.stats;
+        if (sentence.ends_paragraph) {
+            size_t end = sentence.end;
+            paragraphStats.paragraphs = 1;
+            paragraphStats.characters = end - begin;
+            stats += paragraphStats;
+            return std::string_view(m_current.text).substr(begin, end - begin);
+        }
+    }
+}
@@ -0,0 +1,103 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include "alias.hpp"
+#include "grammar.hpp"
+#include "random.hpp"
+#include "source.hpp"
+#include "types.hpp"
+#include "wordtable.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief TextSource that generates paragraphs on a pool of worker threads.
+ *
+ * The text is cut into blocks of Config::PARALLEL_BLOCK_PARAGRAPHS paragraphs. Block b is
+ * generated by its own Grammar / Lexicon pair from an engine seeded with (seed, b), so a
+ * block's contents do not depend on which worker made it or on the number of threads.
+ * Workers run at most a few blocks ahead of the consumer, which keeps memory bounded.
+ *
+ * Because every block is seeded on its own, the source can start at any paragraph: it
+ * generates only the block holding it and the ones after, so paragraph K costs the same
+ * as paragraph 0.
+ */
+class ParallelSource : public TextSource {
+public:
+    /**
+     * @p weighted, if set, must be built from @p table; both must outlive the source. The
+     * first paragraph handed out is paragraph @p first_paragraph of the stream.
+     **/
+    ParallelSource(const WordTable& table, const WeightedIndex* weighted, GrammarNS::Mode mode,
+                   bool cached, Random::Engine engine, unsigned int seed, unsigned int threads,
+                   uint64_t first_paragraph = 0);
+
+    ~ParallelSource() override;
+
+    ParallelSource(const ParallelSource&) = delete;
+    ParallelSource& operator=(const ParallelSource&) = delete;
+
+    std::string_view next_sentence(TextStats& stats) override;
+
+    std::string_view next_paragraph(TextStats& stats) override;
+
+    /**
+     * Seeds @p rng for block @p block of the stream selected by @p seed.
+     **/
+    static void seed_block(Random& rng, unsigned int seed, uint64_t block);
+
+private:
+    struct Sentence {
+        size_t    begin;
+        size_t    end;
+        bool      ends_paragraph;
+        TextStats stats;
+    };
+
+    /* Paragraphs stored back to back; sentences within a paragraph are space-separated */
+    struct Block {
+        std::string           text;
+        std::vector<Sentence> sentences;
+    };
+
+    struct Slot {
+        uint64_t block = 0;
+        bool     ready = false;
+        Block    data;
+    };
+
+    const WordTable&         m_table;
+    const WeightedIndex*     m_weighted;
+    GrammarNS::Mode          m_mode;
+    bool                     m_cached; /* Sample skeletons from the SkeletonCache */
+    Random::Engine           m_engine;
+    unsigned int             m_seed;
+
+    std::mutex               m_mutex;
+    std::condition_variable  m_ready;
+    std::condition_variable  m_space;
+    std::vector<Slot>        m_slots;       /* Block b lives in slot b % m_slots.size() */
+    uint64_t                 m_next_claim = 0;
+    uint64_t                 m_next_consume = 0;
+    bool                     m_stop = false;
+    std::vector<std::thread> m_workers;
+
+    Block                    m_current;     /* Block being handed out to the caller */
+    size_t                   m_position = 0;
+    size_t                   m_skip;        /* Paragraphs to pass over at the start of the first block */
+
+    void worker();
+
+    void generate_block(uint64_t block, Block& out, Random& rng, Lexicon& lexicon,
+                        std::vector<Token>& tokens);
+
+    /* Makes sure m_current has an unconsumed sentence, waiting for the next block if needed */
+    void advance();
+};
+
+#endif
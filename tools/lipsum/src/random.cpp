@@ -0,0 +1,92 @@
+#include "random.hpp"
+
+namespace {
+
+/**
+ * @brief std::seed_seq over a fixed number of seed words, without the heap.
+ *
+ * generate() is the algorithm the standard specifies for std::seed_seq ([rand.util.seedseq]),
+ * so an engine seeded from it ends up in the same state, but the words live in an array
+ * instead of a std::vector. Seeding a block stream then allocates nothing.
+ */
+template <size_t N>
+class FixedSeedSeq {
+public:
+    using result_type = uint32_t;
+
+    explicit FixedSeedSeq(const std::array<uint32_t, N>& words) : m_words(words) {}
+
+    size_t size() const { return N; }
+
+    template <typename Iterator>
+    void generate(Iterator begin, Iterator end) const {
+        const size_t n = static_cast<size_t>(end - begin);
+        if (n == 0)
+            return;
+        std::fill(begin, end, 0x8b8b8b8bu);
+        const size_t t = n >= 623 ? 11 : n >= 68 ? 7 : n >= 39 ? 5 : n >= 7 ? 3 : (n - 1) / 2;
+        const size_t p = (n - t) / 2;
+        const size_t q = p + t;
+        const size_t m = std::max(N + 1, n);
+        auto mix = [](uint32_t x) { return x ^ (x >> 27); };
+
+        for (size_t k = 0; k < m; k++) {
+            uint32_t r1 = 1664525u * mix(begin[k % n] ^ begin[(k + p) % n] ^ begin[(k + n - 1) % n]);
+            uint32_t r2 = r1 + static_cast<uint32_t>(k == 0 ? N : k <= N ? k % n + m_words[k - 1] : k % n);
+            begin[(k + p) % n] += r1;
+            begin[(k + q) % n] += r2;
+            begin[k % n] = r2;
+        }
+        for (size_t k = m; k < m + n; k++) {
+            uint32_t r3 = 1566083941u * mix(begin[k % n] + begin[(k + p) % n] + begin[(k + n - 1) % n]);
+            uint32_t r4 = r3 - static_cast<uint32_t>(k % n);
+            begin[(k + p) % n] ^= r3;
+            begin[(k + q) % n] ^= r4;
+            begin[k % n] = r4;
+        }
+    }
+
+private:
+    std::array<uint32_t, N> m_words;
+};
+
+} /* namespace */
+
+Random::Random(Engine engine, uint32_t seed) : m_engine(engine) {
+    this->seed(seed);
+}
+
+void Random::seed(uint32_t seed) {
+    if (m_engine == Engine::MT19937)
+        m_mt.seed(seed);
+    else
+        m_xoshiro.seed(seed);
+}
+
+/**
+ * mt19937 streams are seeded through std::seed_seq's algorithm, as the parallel generator
+ * always has been. For xoshiro256** the seed and stream are mixed separately and combined,
+ * so nearby streams start from unrelated states.
+ **/
+void Random::seed_stream(uint32_t seed, uint64_t stream) {
+    if (m_engine == Engine::MT19937) {
+        FixedSeedSeq<3> seq({ seed, static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32) });
+        m_mt.seed(seq);
+    } else {
+        SplitMix64 seed_mix(seed);
+        SplitMix64 stream_mix(stream ^ 0x6a09e667f3bcc909ULL);
+        m_xoshiro.seed(seed_mix.next() ^ stream_mix.next());
+    }
+}
+
+bool parse_engine(const std::string& name, Random::Engine& engine) {
+    if (name == "mt19937") {
+        engine = Random::Engine::MT19937;
+        return true;
+    }
+    if (name == "xoshiro256") {
+        engine = Random::Engine::XOSHIRO256;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,170 @@
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <random>
+#include <string>
+
+/**
+ * @file random.hpp
+ * @brief The random number layer shared by Grammar, Lexicon and the text sources.
+ *
+ * Random wraps one of two engines behind the handful of draws the generator needs. With
+ * the default mt19937 engine every draw matches the std:: distribution it replaces, so
+ * output for a given --seed is unchanged. xoshiro256** is several times faster, and its
+ * bounded draws use Lemire's multiply-and-reject method, which is exact and needs no
+ * distribution object.
+ */
+
+/**
+ * @brief SplitMix64, used to expand seeds into xoshiro256** state.
+ */
+class SplitMix64 {
+public:
+    explicit SplitMix64(uint64_t seed) : m_state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (m_state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+private:
+    uint64_t m_state;
+};
+
+/**
+ * @brief xoshiro256** 1.0 (Blackman & Vigna).
+ */
+class Xoshiro256 {
+public:
+    explicit Xoshiro256(uint64_t seed = 0) { this->seed(seed); }
+
+    void seed(uint64_t seed) {
+        SplitMix64 mix(seed);
+        for (auto& word : m_state)
+            word = mix.next();
+    }
+
+    uint64_t next() {
+        const uint64_t result = rotl(m_state[1] * 5, 7) * 9;
+        const uint64_t t = m_state[1] << 17;
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = rotl(m_state[3], 45);
+        return result;
+    }
+
+private:
+    std::array<uint64_t, 4> m_state;
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+class Random {
+public:
+    enum class Engine {
+        MT19937,
+        XOSHIRO256
+    };
+
+    explicit Random(Engine engine = Engine::MT19937, uint32_t seed = 1);
+
+    Engine engine() const { return m_engine; }
+
+    void seed(uint32_t seed);
+
+    /**
+     * Seeds stream @p stream of @p seed. Different streams of one seed are independent,
+     * so they can be generated in any order or on different threads.
+     **/
+    void seed_stream(uint32_t seed, uint64_t stream);
+
+    /* 32 uniformly random bits */
+    uint32_t bits() {
+        if (m_engine == Engine::MT19937)
+            return static_cast<uint32_t>(m_mt());
+        return static_cast<uint32_t>(m_xoshiro.next() >> 32);
+    }
+
+    /* Uniform integer in [0, n); n must be at least 1 */
+    size_t below(size_t n) {
+        if (m_engine == Engine::MT19937)
+            return std::uniform_int_distribution<size_t>(0, n - 1)(m_mt);
+        uint64_t x = m_xoshiro.next();
+        unsigned __int128 m = static_cast<unsigned __int128>(x) * n;
+        uint64_t low = static_cast<uint64_t>(m);
+        if (low < n) {
+            uint64_t threshold = -static_cast<uint64_t>(n) % n;
+            while (low < threshold) {
+                x = m_xoshiro.next();
+                m = static_cast<unsigned __int128>(x) * n;
+                low = static_cast<uint64_t>(m);
+            }
+        }
+        return static_cast<size_t>(m >> 64);
+    }
+
+    /* Uniform integer in [low, high] */
+    int between(int low, int high) {
+        if (m_engine == Engine::MT19937)
+            return std::uniform_int_distribution<int>(low, high)(m_mt);
+        return low + static_cast<int>(below(static_cast<size_t>(high - low) + 1));
+    }
+
+    /* Uniform double in [0, 1) */
+    double uniform() {
+        if (m_engine == Engine::MT19937)
+            return std::generate_canonical<double, 53>(m_mt);
+        return static_cast<double>(m_xoshiro.next() >> 11) * 0x1.0p-53;
+    }
+
+    /**
+     * Index drawn with the probabilities behind @p cumulative, as built by
+     * cumulative_weights(). Matches std::discrete_distribution draw for draw.
+     **/
+    template <size_t N>
+    size_t discrete(const std::array<double, N>& cumulative) {
+        double p = uniform();
+        return std::lower_bound(cumulative.begin(), cumulative.end(), p) - cumulative.begin();
+    }
+
+private:
+    Engine       m_engine;
+    std::mt19937 m_mt;
+    Xoshiro256   m_xoshiro;
+};
+
+/**
+ * Normalized running totals of @p weights, computed the way std::discrete_distribution
+ * does so that Random::discrete() picks the same index from the same engine state.
+ **/
+template <size_t N>
+std::array<double, N> cumulative_weights(const std::array<double, N>& weights) {
+    double sum = 0.0;
+    for (double weight : weights)
+        sum += weight;
+    std::array<double, N> cumulative{};
+    double running = 0.0;
+    for (size_t i = 0; i < N; i++) {
+        running += weights[i] / sum;
+        cumulative[i] = running;
+    }
+    cumulative[N - 1] = 1.0;
+    return cumulative;
+}
+
+/**
+ * Parses an engine name ("mt19937" or "xoshiro256"). Returns false for unknown names.
+ **/
+bool parse_engine(const std::string& name, Random::Engine& engine);
+
+#endif
@@ -0,0 +1,191 @@
+#include "scan.hpp"
+
+#ifdef SCAN_X86
+#include <immintrin.h>
+#endif
+
+namespace Scan {
+
+namespace {
+
+/* Per-class bit masks for up to 64 bytes; bit i describes byte i */
+struct Masks {
+    uint64_t space = 0;   /* std::isspace() */
+    uint64_t dot = 0;     /* '.' */
+    uint64_t newline = 0; /* '\n' */
+    uint64_t content = 0; /* Anything that makes a line non-blank */
+};
+
+/* Bytes not counted by a paragraph: the whitespace trim() strips */
+bool is_blank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+Masks scalar_masks(const char* data, size_t length) {
+    Masks masks;
+    /* Missing bytes act as whitespace so a short block ends any word in progress */
+    masks.space = length < 64 ? ~uint64_t(0) << length : 0;
+    for (size_t i = 0; i < length; i++) {
+        uint64_t bit = uint64_t(1) << i;
+        char c = data[i];
+        if (is_space(c)) masks.space |= bit;
+        if (c == '.') masks.dot |= bit;
+        if (c == '\n') masks.newline |= bit;
+        if (!is_blank(c)) masks.content |= bit;
+    }
+    return masks;
+}
+
+/**
+ * @brief Running totals across 64-byte blocks.
+ *
+ * Words are counted at their first byte (a non-space preceded by a space), paragraphs at
+ * the end of each line that held content.
+ */
+class Counter {
+public:
+    void add(const Masks& masks) {
+        uint64_t previous_space = (masks.space << 1) | m_space_carry;
+        m_stats.words += __builtin_popcountll(~masks.space & previous_space);
+        m_space_carry = masks.space >> 63;
+
+        m_stats.sentences += __builtin_popcountll(masks.dot);
+
+        uint64_t content = masks.content;
+        for (uint64_t newlines = masks.newline; newlines != 0; newlines &= newlines - 1) {
+            uint64_t line = (newlines & -newlines) - 1; /* Bytes before this newline */
+            if (m_line_content || (content & line) != 0)
+                m_stats.paragraphs++;
+            m_line_content = false;
+            content &= ~line;
+        }
+        if (content != 0)
+            m_line_content = true;
+    }
+
+    TextStats finish(size_t length) {
+        if (m_line_content)
+            m_stats.paragraphs++;
+        m_stats.characters = length;
+        return m_stats;
+    }
+
+private:
+    TextStats m_stats;
+    uint64_t  m_space_carry = 1; /* The text starts as if after a space */
+    bool      m_line_content = false;
+};
+
+#ifdef SCAN_X86
+
+uint64_t movemask16(__m128i bits) {
+    return static_cast<uint16_t>(_mm_movemask_epi8(bits));
+}
+
+__attribute__((target("avx2")))
+uint64_t movemask32(__m256i bits) {
+    return static_cast<uint32_t>(_mm256_movemask_epi8(bits));
+}
+
+#endif
+
+} /* namespace */
+
+#ifdef SCAN_X86
+
+TextStats count_sse2(const char* data, size_t length) {
+    const __m128i tab = _mm_set1_epi8('\t'), control_max = _mm_set1_epi8('\r' - '\t');
+    const __m128i space = _mm_set1_epi8(' '), dot = _mm_set1_epi8('.');
+    const __m128i newline = _mm_set1_epi8('\n'), carriage = _mm_set1_epi8('\r');
+
+    Counter counter;
+    size_t i = 0;
+    for (; i + 64 <= length; i += 64) {
+        Masks masks;
+        for (int part = 0; part < 4; part++) {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 16 * part));
+            __m128i control = _mm_sub_epi8(bytes, tab);
+            __m128i is_control = _mm_cmpeq_epi8(_mm_min_epu8(control, control_max), control);
+            __m128i is_space = _mm_cmpeq_epi8(bytes, space);
+            __m128i is_newline = _mm_cmpeq_epi8(bytes, newline);
+            __m128i is_blank = _mm_or_si128(_mm_or_si128(is_space, is_newline),
+                                            _mm_or_si128(_mm_cmpeq_epi8(bytes, tab),
+                                                         _mm_cmpeq_epi8(bytes, carriage)));
+            int shift = 16 * part;
+            masks.space |= movemask16(_mm_or_si128(is_control, is_space)) << shift;
+            masks.dot |= movemask16(_mm_cmpeq_epi8(bytes, dot)) << shift;
+            masks.newline |= movemask16(is_newline) << shift;
+            masks.content |= (movemask16(is_blank) ^ 0xFFFF) << shift;
+        }
+        counter.add(masks);
+    }
+    if (i < length)
+        counter.add(scalar_masks(data + i, length - i));
+    return counter.finish(length);
+}
+
+__attribute__((target("avx2")))
+TextStats count_avx2(const char* data, size_t length) {
+    const __m256i tab = _mm256_set1_epi8('\t'), control_max = _mm256_set1_epi8('\r' - '\t');
+    const __m256i space = _mm256_set1_epi8(' '), dot = _mm256_set1_epi8('.');
+    const __m256i newline = _mm256_set1_epi8('\n'), carriage = _mm256_set1_epi8('\r');
+
+    Counter counter;
+    size_t i = 0;
+    for (; i + 64 <= length; i += 64) {
+        Masks masks;
+        for (int part = 0; part < 2; part++) {
+            __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 32 * part));
+            __m256i control = _mm256_sub_epi8(bytes, tab);
+            __m256i is_control = _mm256_cmpeq_epi8(_mm256_min_epu8(control, control_max), control);
+            __m256i is_space = _mm256_cmpeq_epi8(bytes, space);
+            __m256i is_newline = _mm256_cmpeq_epi8(bytes, newline);
+            __m256i is_blank = _mm256_or_si256(_mm256_or_si256(is_space, is_newline),
+                                               _mm256_or_si256(_mm256_cmpeq_epi8(bytes, tab),
+                                                               _mm256_cmpeq_epi8(bytes, carriage)));
+            int shift = 32 * part;
+            masks.space |= movemask32(_mm256_or_si256(is_control, is_space)) << shift;
+            masks.dot |= movemask32(_mm256_cmpeq_epi8(bytes, dot)) << shift;
+            masks.newline |= movemask32(is_newline) << shift;
+            masks.content |= (movemask32(is_blank) ^ 0xFFFFFFFFu) << shift;
+        }
+        counter.add(masks);
+    }
+    if (i < length)
+        counter.add(scalar_masks(data + i, length - i));
+    return counter.finish(length);
+}
+
+#endif
+
+namespace {
+
+using CountFunction = TextStats (*)(const char*, size_t);
+
+CountFunction select_count() {
+#ifdef SCAN_X86
+    if (__builtin_cpu_supports("avx2"))
+        return count_avx2;
+    return count_sse2;
+#else
+    return count_text_scalar;
+#endif
+}
+
+} /* namespace */
+
+TextStats count_text_scalar(const char* data, size_t length) {
+    Counter counter;
+    for (size_t i = 0; i < length; i += 64) {
+        size_t block = length - i < 64 ? length - i : 64;
+        counter.add(scalar_masks(data + i, block));
+    }
+    return counter.finish(length);
+}
+
+TextStats count_text(const char* data, size_t length) {
+    static const CountFunction count = select_count();
+    return count(data, length);
+}
+
+} /* namespace Scan */
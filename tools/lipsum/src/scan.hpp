@@ -0,0 +1,127 @@
+#ifndef SCAN_HPP
+#define SCAN_HPP
+
+#include "types.hpp"
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SCAN_X86 1
+#endif
+
+/**
+ * @file scan.hpp
+ * @brief Vectorized byte scanning for the normalizer and the counting helpers.
+ *
+ * Whitespace means the bytes std::isspace() accepts in the "C" locale (space and \t \n
+ * \v \f \r), which is what the iostream-based helpers these replace split on. The SIMD
+ * paths use SSE2 (AVX2 for whole-text counting when the CPU has it) and fall back to
+ * plain loops elsewhere; all paths give the same results.
+ */
+
+namespace Scan {
+
+inline bool is_space(char c) {
+    return c == ' ' || static_cast<unsigned char>(c - '\t') <= '\r' - '\t';
+}
+
+#ifdef __SSE2__
+/* Bit i set if data[i] is whitespace, for 16 bytes */
+inline uint32_t space_mask16(const char* data) {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    __m128i control = _mm_sub_epi8(bytes, _mm_set1_epi8('\t'));
+    __m128i in_range = _mm_cmpeq_epi8(_mm_min_epu8(control, _mm_set1_epi8('\r' - '\t')), control);
+    __m128i space = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(' '));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(in_range, space)));
+}
+#endif
+
+/* Offset of the first whitespace byte in [from, length), or length if there is none */
+inline size_t find_space(const char* data, size_t from, size_t length) {
+#ifdef __SSE2__
+    for (; from + 16 <= length; from += 16) {
+        uint32_t mask = space_mask16(data + from);
+        if (mask != 0)
+            return from + static_cast<size_t>(__builtin_ctz(mask));
+    }
+#endif
+    while (from < length && !is_space(data[from]))
+        from++;
+    return from;
+}
+
+/**
+ * @brief The bytes find_any() looks for: the first @c count of @c bytes, and every control
+ * byte (below 0x20) if @c controls is set.
+ */
+struct ByteSet {
+    char   bytes[16];
+    size_t count;
+    bool   controls;
+
+    bool contains(char c) const {
+        if (controls && static_cast<unsigned char>(c) < 0x20)
+            return true;
+        for (size_t i = 0; i < count; i++) {
+            if (bytes[i] == c)
+                return true;
+        }
+        return false;
+    }
+};
+
+/* Offset of the first byte of @p set in [from, length), or length if there is none */
+inline size_t find_any(const char* data, size_t from, size_t length, const ByteSet& set) {
+#ifdef __SSE2__
+    for (; from + 16 <= length; from += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + from));
+        __m128i hits = _mm_setzero_si128();
+        if (set.controls)
+            hits = _mm_cmpeq_epi8(_mm_min_epu8(bytes, _mm_set1_epi8(0x1f)), bytes);
+        for (size_t i = 0; i < set.count; i++)
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(bytes, _mm_set1_epi8(set.bytes[i])));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+        if (mask != 0)
+            return from + static_cast<size_t>(__builtin_ctz(mask));
+    }
+#endif
+    while (from < length && !set.contains(data[from]))
+        from++;
+    return from;
+}
+
+/**
+ * Offset of the first non-whitespace byte in [from, length), or length. Sets @p newline
+ * if the skipped run contains a '\n'.
+ **/
+inline size_t find_word(const char* data, size_t from, size_t length, bool& newline) {
+    for (; from < length && is_space(data[from]); from++) {
+        if (data[from] == '\n')
+            newline = true;
+    }
+    return from;
+}
+
+/**
+ * Counts @p text in a single pass: words (whitespace-separated), sentences ('.'
+ * characters), paragraphs (lines holding anything besides ' ', \t and \r) and characters
+ * (bytes).
+ **/
+TextStats count_text(const char* data, size_t length);
+
+/* count_text() without SIMD; the reference the vector paths must match */
+TextStats count_text_scalar(const char* data, size_t length);
+
+#ifdef SCAN_X86
+/* The vector paths count_text() picks from; count_avx2() needs a CPU with AVX2 */
+TextStats count_sse2(const char* data, size_t length);
+TextStats count_avx2(const char* data, size_t length);
+#endif
+
+} /* namespace Scan */
+
+#endif
@@ -0,0 +1,363 @@
+#include "server.hpp"
+#include "alias.hpp"
+#include "config.hpp"
+#include "generate.hpp"
+#include "options.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <ostream>
+#include <streambuf>
+#include <system_error>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+const size_t MAX_REQUEST_LINE = 4096;
+
+using Clock = std::chrono::steady_clock;
+
+bool send_all(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t sent = ::send(fd, data, length, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        data += sent;
+        length -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+bool send_line(int fd, const std::string& line) {
+    std::string framed = line + "\n";
+    return send_all(fd, framed.data(), framed.size());
+}
+
+/**
+ * Reads up to the first '\n' into @p line, starting with the bytes already read into
+ * @p rest by an earlier call. Bytes after it are left in @p rest. Returns false on EOF
+ * before a newline, a read error (including a receive timeout), an over-long line, or a
+ * line still incomplete at @p deadline.
+ **/
+bool read_line(int fd, std::string& line, std::string& rest,
+               Clock::time_point deadline = Clock::time_point::max()) {
+    std::string data = std::move(rest);
+    char chunk[4096];
+    while (true) {
+        size_t newline = data.find('\n');
+        if (newline != std::string::npos) {
+            line = data.substr(0, newline);
+            rest = data.substr(newline + 1);
+            return true;
+        }
+        if (data.size() > MAX_REQUEST_LINE || Clock::now() > deadline)
+            return false;
+        ssize_t received = ::read(fd, chunk, sizeof(chunk));
+        if (received < 0 && errno == EINTR)
+            continue;
+        if (received <= 0)
+            return false;
+        data.append(chunk, static_cast<size_t>(received));
+    }
+}
+
+std::vector<std::string> split_words(const std::string& line) {
+    std::vector<std::string> words;
+    size_t i = 0;
+    while (i < line.size()) {
+        while (i < line.size() && std::isspace(static_cast<unsigned char>(line[i])))
+            i++;
+        size_t begin = i;
+        while (i < line.size() && !std::isspace(static_cast<unsigned char>(line[i])))
+            i++;
+        if (i > begin)
+            words.push_back(line.substr(begin, i - begin));
+    }
+    return words;
+}
+
+/**
+ * @brief Unbuffered stream buffer over a socket that sends each write as one chunk of the
+ * response framing. OutputWriter already hands it large chunks, so a second layer of
+ * buffering would only add a copy.
+ */
+class SocketBuffer : public std::streambuf {
+public:
+    explicit SocketBuffer(int fd) : m_fd(fd) {}
+
+    /* Whether a send failed, so the connection can carry nothing more */
+    bool failed() const { return m_failed; }
+
+protected:
+    std::streamsize xsputn(const char* data, std::streamsize length) override {
+        return send_chunk(data, static_cast<size_t>(length)) ? length : 0;
+    }
+
+    int_type overflow(int_type c) override {
+        if (traits_type::eq_int_type(c, traits_type::eof()))
+            return traits_type::not_eof(c);
+        char byte = traits_type::to_char_type(c);
+        return send_chunk(&byte, 1) ? c : traits_type::eof();
+    }
+
+private:
+    int  m_fd;
+    bool m_failed = false;
+
+    bool send_chunk(const char* data, size_t length) {
+        if (length == 0)
+            return true;
+        if (!m_failed)
+            m_failed = !send_line(m_fd, std::to_string(length)) || !send_all(m_fd, data, length);
+        return !m_failed;
+    }
+};
+
+/* @p message as one protocol line: a line break inside it would end the frame early */
+std::string error_line(const std::string& message) {
+    std::string line = message.compare(0, 6, "Error:") == 0 ? message : "Error: " + message;
+    std::replace(line.begin(), line.end(), '\n', ' ');
+    return line;
+}
+
+/* Options that select server-wide resources or another mode can't change per request */
+bool allowed_in_request(const Options& opts) {
+    return opts.dict_path.empty() && !opts.debug_mode && !opts.parallel && !opts.stats &&
+           !opts.show_help && !opts.history && !opts.list_skeletons && !opts.vmsplice &&
+           opts.docs == 0 && opts.model_path.empty() && opts.train_path.empty() &&
+           opts.serve_path.empty() && opts.client_path.empty();
+}
+
+void handle_connection(int fd, const WordTable& table, const WeightedIndex& weighted) {
+    std::string line, rest;
+    if (!read_line(fd, line, rest, Clock::now() + std::chrono::seconds(Config::SERVER_REQUEST_SECONDS)))
+        return;
+
+    Options opts;
+    try {
+        opts = parse_options(split_words(line));
+    } catch (const std::exception& e) {
+        send_line(fd, error_line(e.what()));
+        return;
+    }
+    if (!allowed_in_request(opts)) {
+        send_line(fd, "Error: -h, --history, --skeletons, --dict, --debug, --threads, --stats, "
+                      "--vmsplice, --docs, --train, --model, --serve and --client are not available "
+                      "in a server request.");
+        return;
+    }
+
+    if (!send_line(fd, "OK"))
+        return;
+    SocketBuffer buffer(fd);
+    std::ostream out(&buffer);
+    try {
+        generate_text(opts, table, &weighted, out);
+    } catch (const std::exception& e) {
+        /* A failed send means the client hung up or stalled; anything else it should hear about */
+        if (!buffer.failed())
+            send_line(fd, error_line(e.what()));
+        return;
+    }
+    send_line(fd, "0");
+}
+
+void set_timeout(int fd, int option, int seconds) {
+    timeval timeout = {};
+    timeout.tv_sec = seconds;
+    ::setsockopt(fd, SOL_SOCKET, option, &timeout, sizeof(timeout));
+}
+
+void accept_loop(int listener, const WordTable& table, const WeightedIndex& weighted) {
+    while (true) {
+        int fd = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED || errno == EMFILE || errno == ENFILE)
+                continue;
+            std::cerr << "Error: accept failed: " << std::strerror(errno) << "\n";
+            return;
+        }
+        /* A worker serves one connection at a time, so an idle or stalled client must not keep it */
+        set_timeout(fd, SO_RCVTIMEO, Config::SERVER_REQUEST_SECONDS);
+        set_timeout(fd, SO_SNDTIMEO, Config::SERVER_SEND_SECONDS);
+        handle_connection(fd, table, weighted);
+        ::close(fd);
+    }
+}
+
+/* The length in a chunk header line; false unless it is a positive decimal number */
+bool chunk_length(const std::string& header, size_t& length) {
+    if (header.empty() || header.size() > 18 ||
+        !std::all_of(header.begin(), header.end(), [](unsigned char c) { return std::isdigit(c); }))
+        return false;
+    length = std::stoull(header);
+    return length > 0;
+}
+
+/**
+ * Copies the text chunks of a response to stdout up to its "0" line, starting with the
+ * bytes already read into @p rest. Returns "" once the text is complete (or stdout failed),
+ * else the error to report: the server's, or that the response was cut short.
+ **/
+std::string receive_text(int fd, std::string& rest) {
+    const std::string short_response = "Error: the response ended early.";
+    std::string header;
+    char chunk[1 << 16];
+    while (std::cout) {
+        if (!read_line(fd, header, rest))
+            return short_response;
+        if (header == "0")
+            return "";
+        if (header.compare(0, 6, "Error:") == 0)
+            return header;
+        size_t length;
+        if (!chunk_length(header, length))
+            return "Error: malformed response.";
+
+        size_t buffered = std::min(length, rest.size());
+        std::cout.write(rest.data(), static_cast<std::streamsize>(buffered));
+        rest.erase(0, buffered);
+        length -= buffered;
+        while (length > 0 && std::cout) {
+            ssize_t received = ::read(fd, chunk, std::min(length, sizeof(chunk)));
+            if (received < 0 && errno == EINTR)
+                continue;
+            if (received <= 0)
+                return short_response;
+            std::cout.write(chunk, received);
+            length -= static_cast<size_t>(received);
+        }
+    }
+    return "";
+}
+
+bool make_address(const std::string& path, sockaddr_un& address) {
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path))
+        return false;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+} /* namespace */
+
+int run_server(const std::string& path, const WordTable& table, unsigned int workers) {
+    sockaddr_un address;
+    if (!make_address(path, address)) {
+        std::cerr << "Error: invalid socket path '" << path << "'.\n";
+        return EXIT_FAILURE;
+    }
+
+    int listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listener < 0) {
+        std::cerr << "Error: socket: " << std::strerror(errno) << "\n";
+        return EXIT_FAILURE;
+    }
+
+    /* A socket file left behind by a server that was killed would make bind() fail */
+    struct stat info;
+    if (::lstat(path.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) {
+        int probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        bool live = probe >= 0 &&
+                    ::connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+        if (probe >= 0)
+            ::close(probe);
+        if (live) {
+            std::cerr << "Error: a server is already listening on " << path << ".\n";
+            ::close(listener);
+            return EXIT_FAILURE;
+        }
+        ::unlink(path.c_str());
+    }
+
+    if (::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listener, SOMAXCONN) != 0) {
+        std::cerr << "Error: cannot listen on " << path << ": " << std::strerror(errno) << "\n";
+        ::close(listener);
+        return EXIT_FAILURE;
+    }
+
+    /* Clients that hang up early must not take the server down */
+    std::signal(SIGPIPE, SIG_IGN);
+
+    WeightedIndex weighted(table);
+    if (workers == 0)
+        workers = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers);
+    for (unsigned int i = 0; i < workers; i++) {
+        threads.emplace_back(accept_loop, listener, std::cref(table), std::cref(weighted));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ::close(listener);
+    return EXIT_FAILURE;
+}
+
+int run_client(const std::string& path, const std::vector<std::string>& args) {
+    std::string request;
+    for (const auto& arg : args) {
+        if (arg.empty() || std::any_of(arg.begin(), arg.end(),
+                                       [](unsigned char c) { return std::isspace(c); })) {
+            std::cerr << "Error: --client arguments cannot be empty or contain whitespace.\n";
+            return EXIT_FAILURE;
+        }
+        if (!request.empty())
+            request += ' ';
+        request += arg;
+    }
+
+    sockaddr_un address;
+    if (!make_address(path, address)) {
+        std::cerr << "Error: invalid socket path '" << path << "'.\n";
+        return EXIT_FAILURE;
+    }
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        std::cerr << "Error: cannot connect to " << path << ": " << std::strerror(errno) << "\n";
+        if (fd >= 0)
+            ::close(fd);
+        return EXIT_FAILURE;
+    }
+
+    /* send_all() does not raise SIGPIPE, so a closed stdout still ends the client like the CLI */
+    std::string status, rest;
+    if (!send_line(fd, request) || !read_line(fd, status, rest)) {
+        std::cerr << "Error: no response from " << path << "\n";
+        ::close(fd);
+        return EXIT_FAILURE;
+    }
+    if (status != "OK") {
+        std::cerr << status << "\n";
+        ::close(fd);
+        return EXIT_FAILURE;
+    }
+
+    std::string error = receive_text(fd, rest);
+    ::close(fd);
+    if (!error.empty()) {
+        std::cerr << error << "\n";
+        return EXIT_FAILURE;
+    }
+    if (!std::cout.flush()) {
+        std::cerr << "Error: write failed\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
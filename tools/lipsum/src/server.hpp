@@ -0,0 +1,44 @@
+#ifndef SERVER_HPP
+#define SERVER_HPP
+
+#include "wordtable.hpp"
+#include <string>
+#include <vector>
+
+/**
+ * @file server.hpp
+ * @brief The --serve daemon and the --client mode that talks to it.
+ *
+ * Protocol, one request per connection over a Unix stream socket:
+ *
+ *   client:  one line of generation options, as on the command line ("-p 3 --seed 7")
+ *   server:  a single line holding the error message, or "OK\n" followed by the text
+ *            exactly as the CLI would print it, in chunks of "<length>\n<bytes>" with the
+ *            length in decimal, and a final "0\n"; then the server closes. If generating
+ *            fails after "OK", an "Error: ..." line takes the place of the next chunk.
+ *
+ * A response that ends without its "0\n" line was cut short, so the client never mistakes
+ * part of the text for all of it.
+ *
+ * Every request is generated from its own Random state seeded from its --seed (1 if not
+ * given), so the text never depends on other requests or on which worker serves it.
+ */
+
+/**
+ * Serves requests on the socket at @p path with @p workers threads (0 = one per hardware
+ * thread), each accepting and answering connections on its own. A client that does not
+ * send its request line within Config::SERVER_REQUEST_SECONDS, or leaves a send of the
+ * text waiting for Config::SERVER_SEND_SECONDS, is disconnected. The vocabulary in @p table stays
+ * loaded for the lifetime of the server. Refuses to start if another server is already
+ * listening on @p path. Only returns on a setup error.
+ **/
+int run_server(const std::string& path, const WordTable& table, unsigned int workers);
+
+/**
+ * Sends @p args as one request to the server at @p path and copies the generated text to
+ * stdout, or the server's error to stderr. Returns the exit status for lipsum, which is
+ * EXIT_FAILURE if the response reports an error or ends early.
+ **/
+int run_client(const std::string& path, const std::vector<std::string>& args);
+
+#endif
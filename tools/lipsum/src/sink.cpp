@@ -0,0 +1,157 @@
+#include "sink.hpp"
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace {
+
+size_t page_size() {
+    long size = ::sysconf(_SC_PAGESIZE);
+    return size > 0 ? static_cast<size_t>(size) : 4096;
+}
+
+bool is_pipe(int fd) {
+    struct stat info;
+    return ::fstat(fd, &info) == 0 && S_ISFIFO(info.st_mode);
+}
+
+} /* namespace */
+
+/**
+ * Buffers are whole pages from mmap(): page-aligned, so every spliced page fills one pipe
+ * slot, and unmapping them at the end cannot disturb pages the pipe still references.
+ **/
+AsyncSink::AsyncSink(int fd, bool use_vmsplice, size_t buffer_size, size_t buffers) : m_fd(fd) {
+    const size_t page = page_size();
+    m_buffer_size = (buffer_size + page - 1) / page * page;
+    if (m_buffer_size == 0)
+        m_buffer_size = page;
+    for (size_t i = 0; i < (buffers > 2 ? buffers : 2); i++) {
+        void* memory = ::mmap(nullptr, m_buffer_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            int error = errno;
+            for (char* buffer : m_buffers)
+                ::munmap(buffer, m_buffer_size);
+            throw std::system_error(error, std::generic_category(), "cannot allocate output buffers");
+        }
+        m_buffers.push_back(static_cast<char*>(memory));
+    }
+    m_free = m_buffers;
+
+    if (is_pipe(fd)) {
+        /* A failure leaves the pipe as it was, which only costs throughput */
+        ::fcntl(fd, F_SETPIPE_SZ, static_cast<int>(m_buffer_size));
+        int pipe_size = ::fcntl(fd, F_GETPIPE_SZ);
+        /* A bigger pipe than one buffer could still reference a buffer we hand out again */
+        m_splice = use_vmsplice && pipe_size > 0 && static_cast<size_t>(pipe_size) <= m_buffer_size;
+        m_hold = m_splice;
+        m_pipe_size = pipe_size > 0 ? static_cast<size_t>(pipe_size) : 0;
+    }
+
+    m_thread = std::thread(&AsyncSink::run, this);
+}
+
+AsyncSink::~AsyncSink() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_work.notify_one();
+    m_thread.join();
+    for (char* buffer : m_buffers)
+        ::munmap(buffer, m_buffer_size);
+}
+
+char* AsyncSink::acquire() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return !m_free.empty(); });
+    char* buffer = m_free.back();
+    m_free.pop_back();
+    return buffer;
+}
+
+void AsyncSink::submit(char* buffer, size_t length) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.push_back({ buffer, length });
+    }
+    m_work.notify_one();
+}
+
+void AsyncSink::finish() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_pending.empty() && !m_busy; });
+    if (m_error != 0)
+        throw std::system_error(m_error, std::generic_category(), "write failed");
+}
+
+void AsyncSink::run() {
+    std::vector<char*> released;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_work.wait(lock, [this] { return m_stopping || !m_pending.empty(); });
+        if (m_pending.empty())
+            return;
+        Pending next = m_pending.front();
+        m_pending.pop_front();
+        bool failed = m_error != 0;
+        m_busy = true;
+        lock.unlock();
+
+        int error = failed ? 0 : send(next.buffer, next.length);
+        if (m_hold && !failed) {
+            m_held.push_back({ next.buffer, m_sent });
+            release_held(released);
+        } else {
+            released.push_back(next.buffer);
+        }
+
+        lock.lock();
+        if (error != 0)
+            m_error = error;
+        m_free.insert(m_free.end(), released.begin(), released.end());
+        released.clear();
+        m_busy = false;
+        m_done.notify_all();
+    }
+}
+
+int AsyncSink::send(char* buffer, size_t length) {
+    while (length > 0 && m_splice) {
+        struct iovec chunk = { buffer, length };
+        ssize_t spliced = ::vmsplice(m_fd, &chunk, 1, 0);
+        if (spliced < 0) {
+            if (errno == EINTR)
+                continue;
+            /* Not spliceable after all (e.g. no kernel support): copy from here on */
+            m_splice = false;
+            break;
+        }
+        buffer += spliced;
+        length -= static_cast<size_t>(spliced);
+        m_sent += static_cast<size_t>(spliced);
+    }
+    while (length > 0) {
+        ssize_t written = ::write(m_fd, buffer, length);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            return errno;
+        }
+        buffer += written;
+        length -= static_cast<size_t>(written);
+        m_sent += static_cast<size_t>(written);
+    }
+    return 0;
+}
+
+void AsyncSink::release_held(std::vector<char*>& released) {
+    while (!m_held.empty() && m_sent - m_held.front().end >= m_pipe_size) {
+        released.push_back(m_held.front().buffer);
+        m_held.pop_front();
+    }
+}
@@ -0,0 +1,104 @@
+#ifndef SINK_HPP
+#define SINK_HPP
+
+#include "config.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file sink.hpp
+ * @brief Background writer that drains output buffers to a file descriptor.
+ */
+
+/**
+ * @brief A pool of output buffers and a thread that writes filled ones to a descriptor.
+ *
+ * The producer takes an empty buffer with acquire(), fills it and hands it back with
+ * submit(); the writer thread sends buffers out in submission order with large write(2)
+ * calls while the producer fills the next one, so generation and I/O overlap. When the
+ * pool is empty, acquire() waits for the writer, and the run goes at the pace of the
+ * consumer.
+ *
+ * If @p fd is a pipe, the pipe is enlarged to one buffer. With @p use_vmsplice the
+ * buffers are spliced into the pipe by reference instead of copied. A spliced page stays
+ * in the pipe until the reader has consumed it, so a buffer is only reused once a full
+ * pipe's worth of later data has been spliced behind it. That is only safe if the reader
+ * copies the data out with read(2): a reader that splice()s or tee()s it onward (pv does
+ * by default) would see later buffers. Whenever vmsplice cannot be used, the sink falls
+ * back to write(2).
+ */
+class AsyncSink {
+public:
+    AsyncSink(int fd, bool use_vmsplice, size_t buffer_size = Config::OUTPUT_BUFFER_SIZE,
+              size_t buffers = Config::OUTPUT_BUFFERS);
+
+    /* Drains what was submitted, ignoring write errors; call finish() to see them */
+    ~AsyncSink();
+
+    AsyncSink(const AsyncSink&) = delete;
+    AsyncSink& operator=(const AsyncSink&) = delete;
+
+    size_t buffer_size() const { return m_buffer_size; }
+
+    /* An empty buffer of buffer_size() bytes; blocks until the writer frees one */
+    char* acquire();
+
+    /**
+     * Queues the first @p length bytes of @p buffer, which came from acquire(), for
+     * writing. The buffer belongs to the sink again until acquire() returns it.
+     **/
+    void submit(char* buffer, size_t length);
+
+    /**
+     * Waits until everything submitted has been written. Throws std::system_error if a
+     * write failed; data submitted after a failure is discarded.
+     **/
+    void finish();
+
+private:
+    struct Pending {
+        char*  buffer;
+        size_t length;
+    };
+
+    /* A spliced buffer and the bytes sent up to its end; reusable once a pipe's worth follows */
+    struct Held {
+        char*  buffer;
+        size_t end;
+    };
+
+    int                     m_fd;
+    size_t                  m_buffer_size;
+    std::vector<char*>      m_buffers; /* Every buffer, for unmapping */
+    std::vector<char*>      m_free;
+    std::deque<Pending>     m_pending;
+    bool                    m_stopping = false;
+    bool                    m_busy = false; /* The thread is writing a buffer */
+    int                     m_error = 0;    /* errno of the first failed write */
+    std::mutex              m_mutex;
+    std::condition_variable m_work;         /* Signals the thread: pending data or stop */
+    std::condition_variable m_done;         /* Signals the producer: free buffer or idle */
+
+    /* Owned by the writer thread */
+    bool                    m_splice = false; /* Cleared if vmsplice fails; write(2) from then on */
+    bool                    m_hold = false;   /* Keep sent buffers until the pipe has moved past them */
+    size_t                  m_pipe_size = 0;
+    size_t                  m_sent = 0;       /* Bytes sent so far */
+    std::deque<Held>        m_held;
+
+    std::thread             m_thread;
+
+    void run();
+
+    /* Sends one buffer; returns 0 or the errno of the failure */
+    int send(char* buffer, size_t length);
+
+    /* Moves held buffers the pipe can no longer reference back to the free list */
+    void release_held(std::vector<char*>& released);
+};
+
+#endif
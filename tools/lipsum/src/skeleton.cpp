@@ -0,0 +1,169 @@
+#include "skeleton.hpp"
+#include "config.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+
+namespace GrammarNS {
+
+namespace {
+
+/* A run of tokens and the probability of the grammar choosing it */
+struct Variant {
+    std::vector<Token> tokens;
+    double             probability;
+};
+
+std::vector<Variant> noun_phrases() {
+    static const char genders[] = { 'm', 'f', 'n' };
+    const double adjectives[] = { Config::PROB_ZERO_ADJ, Config::PROB_ONE_ADJ, Config::PROB_TWO_ADJ };
+    std::vector<Variant> variants;
+    for (char gender : genders) {
+        for (int count = 0; count < 3; count++) {
+            Variant np{ {}, adjectives[count] / 3.0 };
+            np.tokens.assign(count, Token::word(POS::ADJECTIVE, gender));
+            np.tokens.push_back(Token::word(POS::NOUN, gender));
+            variants.push_back(np);
+        }
+    }
+    return variants;
+}
+
+/* @p head followed by each noun phrase, taken with probability @p probability */
+void add_with_noun_phrase(std::vector<Variant>& variants, Token head, double probability) {
+    for (const Variant& np : noun_phrases()) {
+        Variant variant{ { head }, probability * np.probability };
+        variant.tokens.insert(variant.tokens.end(), np.tokens.begin(), np.tokens.end());
+        variants.push_back(variant);
+    }
+}
+
+std::vector<Variant> verb_phrases(Mode mode) {
+    const Token verb = Token::word(POS::VERB, 'x');
+    std::vector<Variant> variants;
+    if (mode == Mode::SIMPLE) {
+        variants.push_back({ { verb }, 1.0 });
+    } else if (mode == Mode::COMPLEX) {
+        add_with_noun_phrase(variants, verb, 1.0);
+    } else {
+        variants.push_back({ { verb }, 1.0 - Config::PROB_COMPLEX_VP });
+        add_with_noun_phrase(variants, verb, Config::PROB_COMPLEX_VP);
+    }
+    return variants;
+}
+
+std::vector<Variant> prepositional_phrases(Mode mode) {
+    const Token preposition = Token::word(POS::PREPOSITION, 'x');
+    std::vector<Variant> variants;
+    if (mode == Mode::SIMPLE) {
+        variants.push_back({ {}, 1.0 });
+    } else if (mode == Mode::COMPLEX) {
+        add_with_noun_phrase(variants, preposition, 1.0);
+    } else {
+        variants.push_back({ {}, 1.0 - Config::PROB_PP_INCLSION });
+        add_with_noun_phrase(variants, preposition, Config::PROB_PP_INCLSION);
+    }
+    return variants;
+}
+
+const char* pos_name(POS part_of_speech) {
+    static const char* names[] = { "noun", "adj", "verb", "adv", "prep", "conj" };
+    return names[static_cast<size_t>(part_of_speech)];
+}
+
+} /* namespace */
+
+const SkeletonCache& SkeletonCache::get(Mode mode) {
+    if (mode == Mode::SIMPLE) {
+        static const SkeletonCache simple(Mode::SIMPLE);
+        return simple;
+    }
+    if (mode == Mode::COMPLEX) {
+        static const SkeletonCache complex(Mode::COMPLEX);
+        return complex;
+    }
+    static const SkeletonCache normal(Mode::NORMAL);
+    return normal;
+}
+
+/**
+ * Enumerates clauses as NP x VP x PP, in the order the grammar emits them.
+ **/
+SkeletonCache::SkeletonCache(Mode mode) : m_mode(mode) {
+    m_starts.push_back(0);
+    const std::vector<Variant> vps = verb_phrases(mode);
+    const std::vector<Variant> pps = prepositional_phrases(mode);
+    std::vector<Token> clause;
+    for (const Variant& np : noun_phrases()) {
+        for (const Variant& vp : vps) {
+            for (const Variant& pp : pps) {
+                clause = np.tokens;
+                clause.insert(clause.end(), vp.tokens.begin(), vp.tokens.end());
+                clause.insert(clause.end(), pp.tokens.begin(), pp.tokens.end());
+                add_clause(clause, np.probability * vp.probability * pp.probability);
+            }
+        }
+    }
+    m_sampler = AliasTable(m_probabilities.data(), m_probabilities.size());
+
+    if (mode == Mode::SIMPLE) {
+        m_clauses_per_sentence = { 1.0, 0.0, 0.0 };
+    } else if (mode == Mode::COMPLEX) {
+        m_clauses_per_sentence = { 0.0, 0.0, 1.0 };
+    } else {
+        m_clauses_per_sentence = { 1.0 - Config::PROB_SECOND_CLAUSE,
+                                   Config::PROB_SECOND_CLAUSE * (1.0 - Config::PROB_THIRD_CLAUSE),
+                                   Config::PROB_SECOND_CLAUSE * Config::PROB_THIRD_CLAUSE };
+    }
+    m_clauses_cumulative = cumulative_weights<3>(m_clauses_per_sentence);
+}
+
+void SkeletonCache::add_clause(const std::vector<Token>& tokens, double probability) {
+    m_tokens.insert(m_tokens.end(), tokens.begin(), tokens.end());
+    m_starts.push_back(static_cast<uint32_t>(m_tokens.size()));
+    m_probabilities.push_back(probability);
+}
+
+void SkeletonCache::emit_sentence(Random& rng, std::vector<Token>& tokens) const {
+    size_t clauses = 3;
+    if (m_mode == Mode::SIMPLE)
+        clauses = 1;
+    else if (m_mode == Mode::NORMAL)
+        clauses = rng.discrete(m_clauses_cumulative) + 1;
+
+    for (size_t i = 0; i < clauses; i++) {
+        if (i > 0) {
+            tokens.push_back(Token::punctuation(Punct::COMMA));
+            tokens.push_back(Token::word(POS::CONJUNCTION, 'x'));
+        }
+        size_t clause = m_sampler.sample(rng);
+        tokens.insert(tokens.end(), clause_begin(clause), clause_end(clause));
+    }
+    tokens.push_back(Token::punctuation(Punct::PERIOD));
+}
+
+void SkeletonCache::describe(std::ostream& out) const {
+    std::vector<size_t> order(clause_count());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return m_probabilities[a] > m_probabilities[b];
+    });
+
+    char buffer[32];
+    for (size_t i = 1; i <= 3; i++) {
+        std::snprintf(buffer, sizeof(buffer), "%.6f", m_clauses_per_sentence[i - 1]);
+        out << buffer << "  " << i << (i == 1 ? " clause" : " clauses") << " per sentence\n";
+    }
+    for (size_t clause : order) {
+        std::snprintf(buffer, sizeof(buffer), "%.6f", m_probabilities[clause]);
+        out << buffer << " ";
+        for (const Token* token = clause_begin(clause); token != clause_end(clause); ++token) {
+            out << ' ' << pos_name(token->pos);
+            if (token->required_gender != 'x')
+                out << '.' << token->required_gender;
+        }
+        out << '\n';
+    }
+}
+
+} /* namespace GrammarNS */
@@ -0,0 +1,71 @@
+#ifndef SKELETON_HPP
+#define SKELETON_HPP
+
+#include "alias.hpp"
+#include "grammar.hpp"
+#include "random.hpp"
+#include "types.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace GrammarNS {
+
+/**
+ * @brief Every clause shape a Mode can produce, with its probability.
+ *
+ * A clause is an NP, a VP and an optional PP, and the grammar makes its choices for one
+ * clause independently of the others: each NP's gender and adjective count, whether the
+ * VP takes an object, whether there is a PP. So the shapes, genders included, form a
+ * small finite set (900 in normal mode) whose probabilities are products of the Config
+ * values. The cache enumerates them once; a sentence is then one draw for its clause
+ * count and one alias-table draw per clause, with the clause tokens copied in whole.
+ *
+ * The distribution of skeletons is the grammar's exactly (up to the 32-bit resolution of
+ * the alias thresholds), but the random draws differ, so a cached run does not give the
+ * same text for a seed as an uncached one.
+ */
+class SkeletonCache {
+public:
+    /* The cache for @p mode, built on first use and shared from then on */
+    static const SkeletonCache& get(Mode mode);
+
+    explicit SkeletonCache(Mode mode);
+
+    /* Appends the skeleton of one sentence to @p tokens */
+    void emit_sentence(Random& rng, std::vector<Token>& tokens) const;
+
+    size_t clause_count() const { return m_probabilities.size(); }
+
+    double clause_probability(size_t clause) const { return m_probabilities[clause]; }
+
+    const Token* clause_begin(size_t clause) const { return m_tokens.data() + m_starts[clause]; }
+
+    const Token* clause_end(size_t clause) const { return m_tokens.data() + m_starts[clause + 1]; }
+
+    /* Probability of a sentence having 1, 2 or 3 clauses */
+    const std::array<double, 3>& clauses_per_sentence() const { return m_clauses_per_sentence; }
+
+    /**
+     * Lists the clause shapes, most likely first, and the clause count distribution,
+     * one per line.
+     **/
+    void describe(std::ostream& out) const;
+
+private:
+    Mode                  m_mode;
+    std::vector<Token>    m_tokens;        /* Every clause's tokens, back to back */
+    std::vector<uint32_t> m_starts;        /* Clause i is m_tokens[m_starts[i], m_starts[i + 1]) */
+    std::vector<double>   m_probabilities; /* Parallel to the clauses */
+    AliasTable            m_sampler;
+    std::array<double, 3> m_clauses_per_sentence;
+    std::array<double, 3> m_clauses_cumulative;
+
+    void add_clause(const std::vector<Token>& tokens, double probability);
+};
+
+} /* namespace GrammarNS */
+
+#endif
@@ -0,0 +1,71 @@
+#include "source.hpp"
+#include "config.hpp"
+
+int draw_paragraph_length(Random& rng) {
+    return rng.between(4, MAX_PARAGRAPH_SENTENCES);
+}
+
+void append_sentence(std::string& text, const std::vector<Token>& tokens, Lexicon& lexicon,
+                     TextStats& stats) {
+    append_sentence(text, tokens.data(), tokens.data() + tokens.size(), lexicon, stats);
+}
+
+void append_sentence(std::string& text, const Token* first, const Token* last, Lexicon& lexicon,
+                     TextStats& stats) {
+    bool separate = !text.empty();
+    if (separate)
+        text += ' ';
+    size_t begin = text.size();
+    lexicon.fillTokens(first, last, text, stats);
+    if (separate && text.size() == begin)
+        text.pop_back();
+}
+
+void TextSource::generate_sentences(size_t count, std::string& sink, TextStats& stats) {
+    for (size_t i = 0; i < count; i++) {
+        std::string_view sentence = next_sentence(stats);
+        if (!sink.empty() && !sentence.empty())
+            sink += ' ';
+        sink += sentence;
+    }
+}
+
+/**
+ * Arenas sized for a full batch of the longest sentences and the text for a paragraph of
+ * them, so no rare long batch or paragraph grows them.
+ **/
+SequentialSource::SequentialSource(GrammarNS::Grammar& grammar, Lexicon& lexicon, Random& rng)
+    : m_grammar(grammar), m_lexicon(lexicon), m_rng(rng) {
+    m_tokens.reserve(Config::SENTENCE_BATCH * GrammarNS::MAX_SENTENCE_TOKENS);
+    m_ends.reserve(Config::SENTENCE_BATCH);
+    const size_t sentence = lexicon.max_sentence_size(GrammarNS::MAX_SENTENCE_TOKENS) + 1;
+    m_text.reserve(MAX_PARAGRAPH_SENTENCES * sentence);
+}
+
+std::string_view SequentialSource::next_sentence(TextStats& stats) {
+    m_grammar.generate_sentence_skeleton(m_tokens);
+    m_text.clear();
+    m_lexicon.fillTokens(m_tokens, m_text, stats);
+    return m_text;
+}
+
+std::string_view SequentialSource::next_paragraph(TextStats& stats) {
+    int sentenceCount = draw_paragraph_length(m_rng);
+    m_text.clear();
+    TextStats paragraphStats;
+    generate_sentences(static_cast<size_t>(sentenceCount), m_text, paragraphStats);
+    paragraphStats.paragraphs = m_text.empty() ? 0 : 1;
+    paragraphStats.characters = m_text.size();
+    stats += paragraphStats;
+    return m_text;
+}
+
+void SequentialSource::generate_sentences(size_t count, std::string& sink, TextStats& stats) {
+    m_grammar.generate_sentence_skeletons(count, m_tokens, m_ends);
+    const Token* first = m_tokens.data();
+    for (size_t end : m_ends) {
+        const Token* last = m_tokens.data() + end;
+        append_sentence(sink, first, last, m_lexicon, stats);
+        first = last;
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef SOURCE_HPP
+#define SOURCE_HPP
+
+#include "grammar.hpp"
+#include "lexicon.hpp"
+#include "random.hpp"
+#include "types.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Where the sizing logic gets its sentences and paragraphs from.
+ *
+ * Returned views stay valid until the next call on the same source. Every call adds the
+ * counts of the returned text to @p stats.
+ */
+class TextSource {
+public:
+    virtual ~TextSource() = default;
+
+    virtual std::string_view next_sentence(TextStats& stats) = 0;
+
+    /* A paragraph is 4 to 7 sentences joined by single spaces. */
+    virtual std::string_view next_paragraph(TextStats& stats) = 0;
+
+    /**
+     * Appends the next @p count sentences to @p sink, joined by single spaces and
+     * separated by one from anything already there; the same text next_sentence() would
+     * give one at a time. Sizing loops hand whole batches to the writer this way.
+     **/
+    virtual void generate_sentences(size_t count, std::string& sink, TextStats& stats);
+
+    /* No sentence from this source has more words than this */
+    virtual size_t max_sentence_words() const { return GrammarNS::MAX_SENTENCE_WORDS; }
+};
+
+/* Most sentences draw_paragraph_length() gives a paragraph */
+constexpr int MAX_PARAGRAPH_SENTENCES = 7;
+
+/**
+ * Draws a paragraph's sentence count (4 to MAX_PARAGRAPH_SENTENCES) from @p rng.
+ **/
+int draw_paragraph_length(Random& rng);
+
+/**
+ * Fills @p tokens into the end of @p text, separated from what is already there by a
+ * single space (none if either side is empty).
+ **/
+void append_sentence(std::string& text, const std::vector<Token>& tokens, Lexicon& lexicon,
+                     TextStats& stats);
+
+void append_sentence(std::string& text, const Token* first, const Token* last, Lexicon& lexicon,
+                     TextStats& stats);
+
+/**
+ * @brief Generates text one sentence at a time from a single Grammar / Lexicon pair.
+ */
+class SequentialSource : public TextSource {
+public:
+    SequentialSource(GrammarNS::Grammar& grammar, Lexicon& lexicon, Random& rng);
+
+    std::string_view next_sentence(TextStats& stats) override;
+
+    std::string_view next_paragraph(TextStats& stats) override;
+
+    /**
+     * Draws all @p count skeletons into one token arena first and then fills them in one
+     * sweep, so the grammar and lexicon loops each stay hot. The grammar draws from its
+     * own copy of the engine, so this gives exactly the sentence-at-a-time text.
+     **/
+    void generate_sentences(size_t count, std::string& sink, TextStats& stats) override;
+
+private:
+    GrammarNS::Grammar& m_grammar;
+    Lexicon&            m_lexicon;
+    Random&             m_rng;
+    std::vector<Token>  m_tokens; /* Skeleton arena reused for every batch */
+    std::vector<size_t> m_ends;   /* End of each sentence's skeleton in m_tokens */
+    std::string         m_text;
+};
+
+#endif
@@ -0,0 +1,92 @@
+#include "stats.hpp"
+
+#ifdef LIPSUM_STATS
+
+#include <cstdio>
+
+namespace Stats {
+
+bool g_enabled = false;
+
+namespace {
+
+/* Workers in ParallelSource record too, so everything is a relaxed atomic */
+std::atomic<uint64_t> g_counters[static_cast<size_t>(Counter::COUNT)];
+std::atomic<int64_t>  g_timers[static_cast<size_t>(Timer::COUNT)]; /* nanoseconds */
+std::atomic<uint64_t> g_allocations;
+uint64_t              g_allocations_at_enable = 0; /* Reported counts start here */
+
+double seconds(Timer timer) {
+    return g_timers[static_cast<size_t>(timer)].load(std::memory_order_relaxed) / 1e9;
+}
+
+uint64_t count(Counter counter) {
+    return g_counters[static_cast<size_t>(counter)].load(std::memory_order_relaxed);
+}
+
+} /* namespace */
+
+void enable() {
+    g_allocations_at_enable = allocations();
+    g_enabled = true;
+}
+
+void add(Counter counter, uint64_t amount) {
+    if (g_enabled)
+        g_counters[static_cast<size_t>(counter)].fetch_add(amount, std::memory_order_relaxed);
+}
+
+uint64_t allocations() {
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+void count_allocation() {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void add_time(Timer timer, std::chrono::steady_clock::duration elapsed) {
+    int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    g_timers[static_cast<size_t>(timer)].fetch_add(ns, std::memory_order_relaxed);
+}
+
+/**
+ * Timers are summed over all threads, so with --threads they can exceed the wall time.
+ **/
+void report(std::ostream& out, double wall_seconds) {
+    double grammar = seconds(Timer::GRAMMAR);
+    double lexicon = seconds(Timer::LEXICON);
+    double sizing = seconds(Timer::SIZING);
+    double normalization = seconds(Timer::NORMALIZATION);
+    double output_mb = count(Counter::OUTPUT_BYTES) / 1e6;
+
+    char line[128];
+    auto row = [&](const char* label, double value, const char* unit) {
+        std::snprintf(line, sizeof(line), "  %-22s %14.3f %s\n", label, value, unit);
+        out << line;
+    };
+    auto counter_row = [&](const char* label, Counter counter) {
+        std::snprintf(line, sizeof(line), "  %-22s %14llu\n", label,
+                      static_cast<unsigned long long>(count(counter)));
+        out << line;
+    };
+
+    out << "[Stats]\n";
+    row("wall time", wall_seconds * 1e3, "ms");
+    row("grammar", grammar * 1e3, "ms");
+    row("lexicon", lexicon * 1e3, "ms");
+    row("normalization", normalization * 1e3, "ms");
+    row("sizing / trim", sizing * 1e3, "ms (incl. the above)");
+    counter_row("sentences", Counter::SENTENCES);
+    counter_row("tokens", Counter::TOKENS);
+    counter_row("bytes generated", Counter::BYTES);
+    counter_row("bytes written", Counter::OUTPUT_BYTES);
+    std::snprintf(line, sizeof(line), "  %-22s %14llu\n", "heap allocations",
+                  static_cast<unsigned long long>(allocations() - g_allocations_at_enable));
+    out << line;
+    counter_row("gender fallbacks", Counter::FALLBACKS);
+    row("output", wall_seconds > 0 ? output_mb / wall_seconds : 0, "MB/s");
+}
+
+} /* namespace Stats */
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef STATS_HPP
+#define STATS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+#ifdef LIPSUM_STATS
+#include <atomic>
+#include <chrono>
+#endif
+
+/**
+ * @file stats.hpp
+ * @brief Hot-path timers and counters behind --stats.
+ *
+ * Grammar, Lexicon, OutputWriter and main() report into a process-wide set of counters
+ * that --stats prints to stderr when the run ends. Recording is skipped at runtime unless
+ * --stats was given, and the whole module compiles to no-ops when LIPSUM_STATS is not
+ * defined (make STATS=0).
+ */
+
+namespace Stats {
+
+enum class Timer {
+    GRAMMAR,       /* Skeleton generation */
+    LEXICON,       /* Filling skeletons with words */
+    SIZING,        /* The whole sizing / trim phase in main(), including the three others */
+    NORMALIZATION, /* Whitespace normalization in OutputWriter */
+    COUNT
+};
+
+enum class Counter {
+    SENTENCES,
+    TOKENS,
+    BYTES,         /* Bytes of sentence text generated */
+    OUTPUT_BYTES,  /* Bytes written to the output stream */
+    FALLBACKS,     /* Words picked from outside the requested gender */
+    COUNT
+};
+
+#ifdef LIPSUM_STATS
+
+extern bool g_enabled;
+
+inline bool enabled() { return g_enabled; }
+
+void enable();
+
+void add(Counter counter, uint64_t amount = 1);
+
+void add_time(Timer timer, std::chrono::steady_clock::duration elapsed);
+
+/**
+ * Heap allocations since the program started, counted by the operator new hook in
+ * allocations.cpp whether or not stats are enabled. Always 0 when the hook is not linked
+ * in, as in liblipsum.
+ **/
+uint64_t allocations();
+
+/* Called by the hook for every allocation */
+void count_allocation();
+
+/**
+ * @brief Adds the lifetime of the object to @p timer when stats are enabled.
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Timer timer) : m_timer(timer), m_active(enabled()) {
+        if (m_active)
+            m_start = std::chrono::steady_clock::now();
+    }
+
+    ~ScopedTimer() { stop(); }
+
+    /* Ends the measurement early; later calls and the destructor do nothing */
+    void stop() {
+        if (m_active)
+            add_time(m_timer, std::chrono::steady_clock::now() - m_start);
+        m_active = false;
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Timer                                 m_timer;
+    bool                                  m_active;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+/**
+ * Prints every timer and counter, plus output throughput over @p wall_seconds.
+ **/
+void report(std::ostream& out, double wall_seconds);
+
+#else
+
+inline bool enabled() { return false; }
+
+inline void enable() {}
+
+inline void add(Counter, uint64_t = 1) {}
+
+inline uint64_t allocations() { return 0; }
+
+inline void count_allocation() {}
+
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Timer) {}
+
+    void stop() {}
+};
+
+inline void report(std::ostream&, double) {}
+
+#endif
+
+} /* namespace Stats */
+
+#endif
@@ -0,0 +1,30 @@
+#include "text.hpp"
+#include "scan.hpp"
+
+std::string trim(const std::string &str) {
+    const std::string whitespace = " \t\n\r";
+    size_t start = str.find_first_not_of(whitespace);
+    if (start == std::string::npos) return "";
+    size_t end = str.find_last_not_of(whitespace);
+    return str.substr(start, end - start + 1);
+}
+
+size_t count_paragraphs(const std::string &text) {
+    return Scan::count_text(text.data(), text.size()).paragraphs;
+}
+
+size_t count_sentences(const std::string &text) {
+    return Scan::count_text(text.data(), text.size()).sentences;
+}
+
+size_t count_words(const std::string &text) {
+    return Scan::count_text(text.data(), text.size()).words;
+}
+
+bool ends_sentence(std::string_view word) {
+    size_t end = word.size();
+    while (end > 0 && (word[end - 1] == '"' || word[end - 1] == '\'' || word[end - 1] == ')' ||
+                       word[end - 1] == ']'))
+        end--;
+    return end > 0 && (word[end - 1] == '.' || word[end - 1] == '!' || word[end - 1] == '?');
+}
@@ -0,0 +1,30 @@
+#ifndef TEXT_HPP
+#define TEXT_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * @file text.hpp
+ * @brief Whole-string helpers the sizing logic uses to measure existing text.
+ *
+ * The counts come from Scan::count_text(); use that directly to get all of them from one
+ * pass.
+ */
+
+std::string trim(const std::string &str);
+
+/* Number of non-blank lines */
+size_t count_paragraphs(const std::string &text);
+
+/* Number of '.' characters */
+size_t count_sentences(const std::string &text);
+
+/* Number of whitespace-separated words */
+size_t count_words(const std::string &text);
+
+/* Whether @p word ends in '.', '!' or '?', possibly followed by closing quotes or brackets */
+bool ends_sentence(std::string_view word);
+
+#endif
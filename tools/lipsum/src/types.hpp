@@ -1,11 +1,15 @@
 #ifndef TYPES_HPP
 #define TYPES_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 #include <unordered_map>
 
-enum class POS {
+enum class POS : uint8_t {
     NOUN,
     ADJECTIVE,
     VERB,
@@ -14,25 +18,79 @@ enum class POS {
     CONJUNCTION,
 };
 
+constexpr size_t POS_COUNT = static_cast<size_t>(POS::CONJUNCTION) + 1;
+
 struct Word {
     std::string text; /* The word itself */
     POS pos; /* Part of Speech */
     char gender; /* Gender for nouns / adjectives ('m', 'f', 'n'). For others, use 'x'. */
+    float weight = 1.0f; /* Relative frequency, used by weighted (--weighted) selection */
 };
 
 using Dictionary = std::unordered_map<POS, std::vector<Word>>;
 
-enum class TokenType {
+enum class TokenType : uint8_t {
     WORD,
     PUNCTUATION
 };
 
+/* Punctuation a skeleton can contain; tokens refer to it by index into PUNCTUATION */
+enum class Punct : uint8_t {
+    COMMA,
+    PERIOD
+};
+
+constexpr std::string_view PUNCTUATION[] = { ",", "." };
+
+/**
+ * @brief One slot of a sentence skeleton, packed into 4 bytes.
+ *
+ * A WORD token asks for a word of @c pos (agreeing with @c required_gender), a
+ * PUNCTUATION token for the interned mark @c punct. Tokens hold no pointers or strings,
+ * so skeletons can be copied with memcpy and cached as plain arrays.
+ */
 struct Token {
     TokenType type;
-    POS pos;
-    char required_gender;
+    POS       pos;
+    char      required_gender;
+    Punct     punct;
+
+    static constexpr Token word(POS part_of_speech, char gender) {
+        return Token{ TokenType::WORD, part_of_speech, gender, Punct::COMMA };
+    }
+
+    static constexpr Token punctuation(Punct mark) {
+        return Token{ TokenType::PUNCTUATION, POS::NOUN, 'x', mark };
+    }
+
+    /* The punctuation mark's text; empty for words */
+    std::string_view text() const {
+        return type == TokenType::PUNCTUATION ? PUNCTUATION[static_cast<size_t>(punct)] : std::string_view();
+    }
+};
+
+static_assert(sizeof(Token) == 4, "Token should stay packed");
+static_assert(std::is_trivially_copyable<Token>::value, "Skeletons are copied with memcpy");
+
+/**
+ * @brief Word, sentence, character and paragraph counts for a piece of generated text.
+ *
+ * Counted the same way the sizing logic counts a whole document (whitespace-separated
+ * words, '.' per sentence, bytes, non-empty lines), so totals can be kept incrementally.
+ */
+struct TextStats {
+    size_t paragraphs = 0;
+    size_t sentences = 0;
+    size_t words = 0;
+    size_t characters = 0;
 
-    std::string text;
+    TextStats& operator+=(const TextStats& other) {
+        paragraphs += other.paragraphs;
+        sentences += other.sentences;
+        words += other.words;
+        characters += other.characters;
+        return *this;
+    }
 };
 
 #endif
@@ -0,0 +1,73 @@
+#include "wordtable.hpp"
+#include <algorithm>
+
+IndexedDictionary::IndexedDictionary(const Dictionary& dict) {
+    size_t total = 0;
+    for (const auto& entry : dict) {
+        total += entry.second.size();
+    }
+    m_words.reserve(total);
+    m_grouped.reserve(total);
+    m_weights.reserve(total);
+    m_grouped_weights.reserve(total);
+
+    /* Offsets first; pointers are filled in once the vectors stop growing */
+    struct Range {
+        size_t words_begin = 0;
+        size_t words_count = 0;
+        size_t genders_begin = 0;
+        size_t genders_count = 0;
+    };
+    std::array<Range, POS_COUNT> ranges{};
+    std::vector<size_t> gender_offsets;
+
+    for (const auto& entry : dict) {
+        size_t slot = static_cast<size_t>(entry.first);
+        if (slot >= POS_COUNT)
+            continue;
+        const auto& words = entry.second;
+        Range& range = ranges[slot];
+
+        range.words_begin = m_words.size();
+        range.words_count = words.size();
+        for (const auto& word : words) {
+            m_words.push_back(word.text);
+            m_weights.push_back(word.weight);
+            m_table.longest_word = std::max(m_table.longest_word, word.text.size());
+        }
+
+        std::vector<char> genders;
+        for (const auto& word : words) {
+            if (std::find(genders.begin(), genders.end(), word.gender) == genders.end())
+                genders.push_back(word.gender);
+        }
+
+        range.genders_begin = m_genders.size();
+        range.genders_count = genders.size();
+        for (char gender : genders) {
+            size_t begin = m_grouped.size();
+            for (const auto& word : words) {
+                if (word.gender == gender) {
+                    m_grouped.push_back(word.text);
+                    m_grouped_weights.push_back(word.weight);
+                }
+            }
+            m_genders.push_back({gender, nullptr, m_grouped.size() - begin});
+            gender_offsets.push_back(begin);
+        }
+    }
+
+    for (size_t i = 0; i < m_genders.size(); i++) {
+        m_genders[i].words = m_grouped.data() + gender_offsets[i];
+        m_genders[i].weights = m_grouped_weights.data() + gender_offsets[i];
+    }
+    for (size_t slot = 0; slot < POS_COUNT; slot++) {
+        const Range& range = ranges[slot];
+        PosWords& part = m_table.parts[slot];
+        part.words = m_words.data() + range.words_begin;
+        part.weights = m_weights.data() + range.words_begin;
+        part.count = range.words_count;
+        part.genders = m_genders.data() + range.genders_begin;
+        part.gender_count = range.genders_count;
+    }
+}
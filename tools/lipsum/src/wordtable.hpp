@@ -0,0 +1,67 @@
+#ifndef WORDTABLE_HPP
+#define WORDTABLE_HPP
+
+#include "types.hpp"
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+/* Contiguous words sharing one gender within a part of speech */
+struct GenderSpan {
+    char                    gender;
+    const std::string_view* words;
+    size_t                  count;
+    const float*            weights = nullptr; /* Parallel to words; null if all are equal */
+};
+
+/* Every word of one part of speech, plus the same vocabulary split into gender runs */
+struct PosWords {
+    const std::string_view* words = nullptr;
+    size_t                  count = 0;
+    const GenderSpan*       genders = nullptr;
+    size_t                  gender_count = 0;
+    const float*            weights = nullptr;
+};
+
+/**
+ * @brief Read-only vocabulary laid out the way Lexicon selects from it.
+ *
+ * The table only points at storage owned elsewhere: an IndexedDictionary, a mapped
+ * dictionary file, or static arrays. Whoever owns that storage must outlive the table.
+ */
+struct WordTable {
+    std::array<PosWords, POS_COUNT> parts;
+    size_t                          longest_word = 0; /* Length of the longest word in any part */
+
+    const PosWords& operator[](POS part_of_speech) const {
+        return parts[static_cast<size_t>(part_of_speech)];
+    }
+};
+
+/**
+ * @brief Presents a Dictionary as a WordTable.
+ *
+ * Built once; afterwards selection never has to filter or copy words. Each POS keeps its
+ * dictionary order and each gender run keeps the relative order of its words, so picking
+ * by index gives the same words as filtering the Dictionary would.
+ */
+class IndexedDictionary {
+public:
+    explicit IndexedDictionary(const Dictionary& dict);
+
+    IndexedDictionary(const IndexedDictionary&) = delete;
+    IndexedDictionary& operator=(const IndexedDictionary&) = delete;
+
+    const WordTable& table() const { return m_table; }
+
+private:
+    std::vector<std::string_view> m_words;   /* Dictionary order, grouped by POS */
+    std::vector<std::string_view> m_grouped; /* Grouped by (POS, gender) */
+    std::vector<float>            m_weights; /* Parallel to m_words */
+    std::vector<float>            m_grouped_weights;
+    std::vector<GenderSpan>       m_genders;
+    WordTable                     m_table;
+};
+
+#endif
@@ -0,0 +1,22 @@
+#include "cli.hpp"
+#include "alias.hpp"
+#include "dictionary.hpp"
+#include "generate.hpp"
+#include "options.hpp"
+#include <memory>
+#include <sstream>
+
+namespace Test {
+
+std::string lipsum(const std::vector<std::string>& args) {
+    Options opts = parse_options(args);
+    const WordTable& table = opts.debug_mode ? get_debug_word_table() : get_test_word_table();
+    std::unique_ptr<WeightedIndex> weighted;
+    if (opts.weighted)
+        weighted = std::make_unique<WeightedIndex>(table);
+    std::ostringstream out;
+    generate_text(opts, table, weighted.get(), out);
+    return out.str();
+}
+
+} /* namespace Test */
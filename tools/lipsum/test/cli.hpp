@@ -0,0 +1,18 @@
+#ifndef TEST_CLI_HPP
+#define TEST_CLI_HPP
+
+#include <string>
+#include <vector>
+
+namespace Test {
+
+/**
+ * What `lipsum @p args` prints for a generating option list, produced in-process the way
+ * main() does: the options parsed by parse_options() and generate_text() run on the
+ * built-in word table.
+ **/
+std::string lipsum(const std::vector<std::string>& args);
+
+} /* namespace Test */
+
+#endif
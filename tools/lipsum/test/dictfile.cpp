@@ -0,0 +1,212 @@
+#include "harness.hpp"
+#include "dictfile.hpp"
+#include "types.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+/*
+ * The dictionary file loader: a well-formed file loads as the table it describes, and
+ * every malformed one is rejected with the reason instead of being used.
+ */
+
+namespace {
+
+/**
+ * @brief The sections of a dictionary file, laid out by bytes() the way
+ * make_binary_dict.py does. Tests break one field and check the loader notices.
+ */
+struct DictImage {
+    DictFileHeader             header = {};
+    std::vector<DictFileRun>   runs;
+    std::vector<DictFileEntry> entries;
+    std::vector<float>         weights;
+    std::string                pool;
+
+    /* Two genders of two words for every part of speech */
+    DictImage() {
+        std::memcpy(header.magic, DICT_FILE_MAGIC, sizeof(header.magic));
+        header.version = DICT_FILE_VERSION;
+        for (size_t pos = 0; pos < POS_COUNT; pos++) {
+            for (char gender : { 'f', 'm' }) {
+                runs.push_back({ static_cast<uint8_t>(pos), gender, 0, static_cast<uint32_t>(entries.size()), 2 });
+                for (int i = 0; i < 2; i++) {
+                    std::string word = "word" + std::to_string(pos) + gender + std::to_string(i);
+                    entries.push_back({ static_cast<uint32_t>(pool.size()), static_cast<uint32_t>(word.size()) });
+                    weights.push_back(1.0f + i);
+                    pool += word;
+                }
+            }
+        }
+        header.run_count = static_cast<uint32_t>(runs.size());
+        header.entry_count = static_cast<uint32_t>(entries.size());
+        header.pool_size = static_cast<uint32_t>(pool.size());
+    }
+
+    /* The file, with the section offsets filled in unless @p keep_offsets */
+    std::string bytes(bool keep_offsets = false) {
+        std::string file(sizeof(DictFileHeader), '\0');
+        auto append = [&file](const void* data, size_t size) {
+            uint32_t offset = static_cast<uint32_t>(file.size());
+            file.append(static_cast<const char*>(data), size);
+            return offset;
+        };
+        uint32_t runs_offset = append(runs.data(), runs.size() * sizeof(DictFileRun));
+        uint32_t entries_offset = append(entries.data(), entries.size() * sizeof(DictFileEntry));
+        uint32_t weights_offset = append(weights.data(), weights.size() * sizeof(float));
+        uint32_t pool_offset = append(pool.data(), pool.size());
+        if (!keep_offsets) {
+            header.runs_offset = runs_offset;
+            header.entries_offset = entries_offset;
+            header.weights_offset = weights_offset;
+            header.pool_offset = pool_offset;
+        }
+        std::memcpy(&file[0], &header, sizeof(header));
+        return file;
+    }
+};
+
+/* Loads @p bytes through a temporary file, which is gone again when it returns */
+std::unique_ptr<MappedDictionary> load(const std::string& bytes) {
+    char path[] = "/tmp/lipsum_test_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0)
+        throw std::runtime_error("cannot create a temporary file");
+    bool written = write(fd, bytes.data(), bytes.size()) == static_cast<ssize_t>(bytes.size());
+    close(fd);
+    try {
+        if (!written)
+            throw std::runtime_error(std::string("cannot write ") + path);
+        auto dictionary = std::make_unique<MappedDictionary>(path);
+        unlink(path);
+        return dictionary;
+    } catch (...) {
+        unlink(path);
+        throw;
+    }
+}
+
+/* The error loading @p bytes gives, or "" if it loads */
+std::string load_error(const std::string& bytes) {
+    try {
+        load(bytes);
+    } catch (const std::runtime_error& e) {
+        return e.what();
+    }
+    return "";
+}
+
+/* Checks that @p image is rejected with a message containing @p reason */
+void check_rejected(DictImage image, const std::string& reason, bool keep_offsets = false) {
+    std::string error = load_error(image.bytes(keep_offsets));
+    if (error.find(reason) == std::string::npos)
+        Test::fail(__FILE__, __LINE__, "expected \"" + reason + "\", got \"" + error + "\"");
+}
+
+TEST(dictfile_loads_valid, "dictfile/valid") {
+    DictImage image;
+    CHECK_EQ(load_error(image.bytes()), "");
+    std::unique_ptr<MappedDictionary> dictionary = load(image.bytes());
+    const WordTable& table = dictionary->table();
+    CHECK_EQ(table.longest_word, std::string("word0f0").size());
+    for (const PosWords& part : table.parts) {
+        CHECK_EQ(part.count, size_t(4));
+        CHECK_EQ(part.gender_count, size_t(2));
+        CHECK_EQ(part.genders[1].gender, 'm');
+        CHECK_EQ(part.weights[1], 2.0f);
+    }
+    CHECK_EQ(table.parts[1].words[0], "word1f0");
+
+    /* Version 1 has no weights section; the offset field is ignored */
+    DictImage unweighted;
+    unweighted.header.version = 1;
+    unweighted.bytes();
+    unweighted.header.weights_offset = 0x7fffffff;
+    CHECK_EQ(load_error(unweighted.bytes(true)), "");
+}
+
+TEST(dictfile_rejects_header, "dictfile/header") {
+    CHECK(load_error("LIPSDICT").find("too small") != std::string::npos);
+
+    DictImage magic;
+    magic.header.magic[0] = 'X';
+    check_rejected(magic, "not a lipsum dictionary");
+
+    DictImage version;
+    version.header.version = DICT_FILE_VERSION + 1;
+    check_rejected(version, "unsupported version");
+}
+
+TEST(dictfile_rejects_sections, "dictfile/sections") {
+    DictImage runs;
+    runs.bytes();
+    runs.header.runs_offset = 0x7fffffff;
+    check_rejected(runs, "section out of bounds", true);
+
+    DictImage entries;
+    entries.bytes();
+    entries.header.entry_count = 1000;
+    check_rejected(entries, "section out of bounds", true);
+
+    DictImage misaligned;
+    misaligned.bytes();
+    misaligned.header.entries_offset += 1;
+    check_rejected(misaligned, "section out of bounds", true);
+
+    DictImage weights;
+    weights.bytes();
+    weights.header.weights_offset = weights.header.pool_offset + 2;
+    check_rejected(weights, "section out of bounds", true);
+}
+
+TEST(dictfile_rejects_words, "dictfile/words") {
+    DictImage offset;
+    offset.entries[3].offset = offset.header.pool_size + 1;
+    check_rejected(offset, "word 3 out of bounds");
+
+    DictImage length;
+    length.entries[5].length = length.header.pool_size;
+    check_rejected(length, "word 5 out of bounds");
+
+    const float bad_weights[] = { -1.0f, std::nanf(""), std::numeric_limits<float>::infinity() };
+    for (float weight : bad_weights) {
+        DictImage image;
+        image.weights[7] = weight;
+        check_rejected(image, "bad weight for word 7");
+    }
+}
+
+TEST(dictfile_rejects_runs, "dictfile/runs") {
+    DictImage empty;
+    empty.runs[2].count = 0;
+    check_rejected(empty, "bad run 2");
+
+    DictImage pos;
+    pos.runs[4].pos = static_cast<uint8_t>(POS_COUNT);
+    check_rejected(pos, "bad run 4");
+
+    DictImage gap;
+    gap.runs[1].first += 1;
+    check_rejected(gap, "bad run 1");
+
+    DictImage overflow;
+    overflow.runs.back().count = 1000;
+    check_rejected(overflow, "bad run " + std::to_string(overflow.runs.size() - 1));
+
+    DictImage order;
+    std::swap(order.runs[0].pos, order.runs[2].pos);
+    check_rejected(order, "runs not sorted by part of speech");
+
+    DictImage uncovered;
+    uncovered.runs.pop_back();
+    uncovered.header.run_count--;
+    check_rejected(uncovered, "runs do not cover every entry");
+}
+
+} /* namespace */
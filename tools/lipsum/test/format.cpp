@@ -0,0 +1,313 @@
+#include "harness.hpp"
+#include "format.hpp"
+#include "output.hpp"
+#include "random.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+ * The --format writers: every capped document is exactly the limit and well-formed, the
+ * text in it never ends in a space, and decoding it gives back the words that went in.
+ */
+
+namespace {
+
+/* Words with every byte some format escapes, UTF-8, and sentence ends */
+const char* const WORDS[] = { "lorem", "ipsum", "fish&chips", "<b>", "a>b", "\"quoted\"", "back\\slash",
+                              "tab\x01stop", "caf\xc3\xa9", "*star*", "_under_", "#hash", "[link]",
+                              "`tick`", "pipe|", "dolor.", "sit!", "amet?", "(end.)", "\"said.\"" };
+
+/* Paragraphs of sentences from WORDS, with the loose whitespace generators produce */
+std::string sample_text(uint64_t seed, int paragraphs) {
+    SplitMix64 rng(seed);
+    std::string text;
+    for (int p = 0; p < paragraphs; p++) {
+        if (p > 0)
+            text += rng.next() % 2 ? "\n\n" : " \n \n\t";
+        int words = 3 + static_cast<int>(rng.next() % 30);
+        for (int w = 0; w < words; w++) {
+            if (w > 0)
+                text += rng.next() % 8 ? " " : "  \t";
+            text += WORDS[rng.next() % (sizeof(WORDS) / sizeof(WORDS[0]))];
+        }
+        text += '.';
+    }
+    return text;
+}
+
+std::vector<std::string> split_words(const std::string& text) {
+    std::istringstream in(text);
+    std::vector<std::string> words;
+    std::string word;
+    while (in >> word)
+        words.push_back(word);
+    return words;
+}
+
+/* @p text normalized and formatted, capped at @p limit bytes, fed in pieces of @p piece */
+std::string render(Format format, const std::string& text, size_t limit, size_t piece = 0) {
+    std::ostringstream out;
+    OutputWriter writer(out, true, 64);
+    writer.set_format(format);
+    writer.set_limit(limit);
+    if (piece == 0)
+        piece = text.size();
+    for (size_t i = 0; i < text.size(); i += piece)
+        writer.write(text.data() + i, std::min(piece, text.size() - i));
+    writer.finish();
+    return out.str();
+}
+
+/* The text of each <h2>, <p> and <li>, unescaped; false if the tags don't nest */
+bool parse_html(const std::string& document, std::vector<std::string>& texts) {
+    std::vector<std::string> open;
+    size_t i = 0;
+    while (i < document.size()) {
+        if (document[i] == '<') {
+            size_t end = document.find('>', i);
+            if (end == std::string::npos)
+                return false;
+            std::string tag = document.substr(i + 1, end - i - 1);
+            i = end + 1;
+            if (tag[0] == '!' || tag.compare(0, 4, "meta") == 0)
+                continue;
+            if (tag[0] == '/') {
+                if (open.empty() || open.back() != tag.substr(1))
+                    return false;
+                open.pop_back();
+            } else {
+                open.push_back(tag);
+                if (tag == "h2" || tag == "p" || tag == "li")
+                    texts.emplace_back();
+            }
+            continue;
+        }
+        const std::string& parent = open.empty() ? std::string() : open.back();
+        bool in_text = parent == "h2" || parent == "p" || parent == "li";
+        char c = document[i];
+        if (c == '>' || (c == '&' && !in_text))
+            return false;
+        if (c == '&') {
+            size_t end = document.find(';', i);
+            if (end == std::string::npos)
+                return false;
+            std::string entity = document.substr(i, end + 1 - i);
+            if (entity == "&amp;") c = '&';
+            else if (entity == "&lt;") c = '<';
+            else if (entity == "&gt;") c = '>';
+            else return false;
+            i = end + 1;
+        } else {
+            i++;
+        }
+        if (in_text)
+            texts.back() += c;
+    }
+    return open.empty();
+}
+
+/**
+ * @brief Reads the JSON subset --format json writes: nested arrays of strings.
+ */
+class JsonReader {
+public:
+    explicit JsonReader(const std::string& text) : m_text(text) {}
+
+    /* The document's strings in order; false unless it is one valid value */
+    bool read(std::vector<std::string>& strings) {
+        if (!value(strings))
+            return false;
+        skip_space();
+        return m_at == m_text.size();
+    }
+
+private:
+    const std::string& m_text;
+    size_t             m_at = 0;
+
+    void skip_space() {
+        while (m_at < m_text.size() && (m_text[m_at] == ' ' || m_text[m_at] == '\n' ||
+                                        m_text[m_at] == '\t' || m_text[m_at] == '\r'))
+            m_at++;
+    }
+
+    bool value(std::vector<std::string>& strings) {
+        skip_space();
+        if (m_at >= m_text.size())
+            return false;
+        if (m_text[m_at] == '"')
+            return string(strings);
+        if (m_text[m_at] != '[')
+            return false;
+        m_at++;
+        skip_space();
+        if (m_at < m_text.size() && m_text[m_at] == ']') {
+            m_at++;
+            return true;
+        }
+        while (true) {
+            if (!value(strings))
+                return false;
+            skip_space();
+            if (m_at >= m_text.size())
+                return false;
+            char c = m_text[m_at++];
+            if (c == ']')
+                return true;
+            if (c != ',')
+                return false;
+        }
+    }
+
+    bool string(std::vector<std::string>& strings) {
+        std::string decoded;
+        m_at++;
+        while (m_at < m_text.size() && m_text[m_at] != '"') {
+            char c = m_text[m_at++];
+            if (static_cast<unsigned char>(c) < 0x20)
+                return false;
+            if (c == '\\') {
+                if (m_at >= m_text.size())
+                    return false;
+                char escape = m_text[m_at++];
+                if (escape == 'u') {
+                    if (m_at + 4 > m_text.size())
+                        return false;
+                    c = static_cast<char>(std::stoi(m_text.substr(m_at, 4), nullptr, 16));
+                    m_at += 4;
+                } else if (escape == '"' || escape == '\\' || escape == '/') {
+                    c = escape;
+                } else {
+                    return false;
+                }
+            }
+            decoded += c;
+        }
+        if (m_at >= m_text.size())
+            return false;
+        m_at++;
+        strings.push_back(decoded);
+        return true;
+    }
+};
+
+/* The Markdown blocks' lines without their markers, unescaped; false if an escape was cut */
+bool parse_markdown(const std::string& document, std::vector<std::string>& texts) {
+    std::istringstream in(document);
+    std::string line;
+    while (std::getline(in, line)) {
+        /* A block cut at the limit before its first word keeps only its marker */
+        if (line.compare(0, 3, "## ") == 0 || line == "##")
+            line.erase(0, 3);
+        else if (line.compare(0, 2, "- ") == 0 || line == "-")
+            line.erase(0, 2);
+        std::string text;
+        for (size_t i = 0; i < line.size(); i++) {
+            if (line[i] == '\\') {
+                if (++i == line.size())
+                    return false;
+            }
+            text += line[i];
+        }
+        texts.push_back(text);
+    }
+    return true;
+}
+
+/* Decodes @p document into the texts of its blocks; false if it is malformed */
+bool parse(Format format, const std::string& document, std::vector<std::string>& texts) {
+    if (format == Format::HTML)
+        return parse_html(document, texts);
+    if (format == Format::JSON)
+        return JsonReader(document).read(texts);
+    return parse_markdown(document, texts);
+}
+
+const Format FORMATS[] = { Format::HTML, Format::MARKDOWN, Format::JSON };
+
+size_t empty_size(Format format) {
+    const Markup& markup = ::markup(format);
+    return markup.document_open.size() + markup.document_close.size();
+}
+
+TEST(format_uncapped_keeps_words, "format/words") {
+    for (uint64_t seed = 1; seed <= 5; seed++) {
+        std::string text = sample_text(seed, 20);
+        for (Format format : FORMATS) {
+            std::string document = render(format, text, SIZE_MAX);
+            std::vector<std::string> texts;
+            CHECK(parse(format, document, texts));
+            std::string joined;
+            for (const std::string& block : texts)
+                joined += block + ' ';
+            CHECK(split_words(joined) == split_words(text));
+        }
+    }
+}
+
+TEST(format_capped_is_exact_and_well_formed, "format/capped") {
+    for (uint64_t seed = 1; seed <= 3; seed++) {
+        std::string text = sample_text(seed, 6);
+        const std::vector<std::string> words = split_words(text);
+        for (Format format : FORMATS) {
+            const std::string uncapped = render(format, text, SIZE_MAX);
+            for (size_t limit = 0; limit < uncapped.size() + 10; limit++) {
+                std::string document = render(format, text, limit);
+                if (limit + 1 >= uncapped.size()) {
+                    CHECK(document == uncapped);
+                    continue;
+                }
+                CHECK_EQ(document.size(), limit + 1);
+                if (limit < empty_size(format))
+                    continue;
+                document.pop_back();
+                std::vector<std::string> texts;
+                if (!parse(format, document, texts)) {
+                    Test::fail(__FILE__, __LINE__, "malformed at " + std::to_string(limit) + ": " + document);
+                    continue;
+                }
+                std::string joined;
+                for (const std::string& block : texts) {
+                    if (!block.empty() && std::isspace(static_cast<unsigned char>(block.back())))
+                        Test::fail(__FILE__, __LINE__, "text ends in a space at " + std::to_string(limit));
+                    joined += block + ' ';
+                }
+                /* A prefix of the words, the last one possibly cut */
+                std::vector<std::string> got = split_words(joined);
+                CHECK(got.size() <= words.size());
+                for (size_t i = 0; i < got.size() && i < words.size(); i++) {
+                    bool last = i + 1 == got.size();
+                    if (last ? words[i].compare(0, got[i].size(), got[i]) != 0 : got[i] != words[i]) {
+                        Test::fail(__FILE__, __LINE__, "word " + std::to_string(i) + " at " +
+                                                           std::to_string(limit) + ": " + got[i]);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(format_pieces_match_whole, "format/pieces") {
+    std::string text = sample_text(9, 12);
+    for (Format format : FORMATS) {
+        for (size_t limit : { size_t(150), size_t(777), SIZE_MAX }) {
+            std::string whole = render(format, text, limit);
+            for (size_t piece : { 1, 3, 16, 100 }) {
+                std::string pieces = render(format, text, limit, piece);
+                if (pieces != whole) {
+                    size_t at = std::mismatch(pieces.begin(), pieces.end(), whole.begin(), whole.end()).first -
+                                pieces.begin();
+                    Test::fail(__FILE__, __LINE__, "pieces of " + std::to_string(piece) + " differ at byte " +
+                                                       std::to_string(at) + ": " + pieces.substr(at, 40));
+                }
+            }
+        }
+    }
+}
+
+} /* namespace */
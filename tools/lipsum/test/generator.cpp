@@ -0,0 +1,78 @@
+#include "harness.hpp"
+#include "cli.hpp"
+#include "lipsum.hpp"
+#include <string>
+#include <vector>
+
+/*
+ * Lipsum::Generator: each unit gives the text the CLI prints for the matching flag with
+ * --no-header, and appending to a buffer that already holds text leaves that text alone.
+ */
+
+namespace {
+
+struct Case {
+    Lipsum::Unit unit;
+    const char*  flag;
+    size_t       count;
+    unsigned int seed;
+};
+
+const Case CASES[] = { { Lipsum::Unit::BYTES, "-b", 1, 3 },         { Lipsum::Unit::BYTES, "-b", 55, 2 },
+                       { Lipsum::Unit::BYTES, "-b", 777, 5 },       { Lipsum::Unit::BYTES, "-b", 777, 6 },
+                       { Lipsum::Unit::BYTES, "-b", 1000, 9 },      { Lipsum::Unit::BYTES, "-b", 100, 11 },
+                       { Lipsum::Unit::BYTES, "-b", 100, 12 },      { Lipsum::Unit::BYTES, "-b", 100000, 4 },
+                       { Lipsum::Unit::WORDS, "-w", 1, 1 },         { Lipsum::Unit::WORDS, "-w", 513, 8 },
+                       { Lipsum::Unit::SENTENCES, "-s", 1, 2 },     { Lipsum::Unit::SENTENCES, "-s", 300, 7 },
+                       { Lipsum::Unit::PARAGRAPHS, "-p", 1, 10 },   { Lipsum::Unit::PARAGRAPHS, "-p", 20, 13 } };
+
+/* The CLI's text for @p c, without the newline it ends with */
+std::string cli_text(const Case& c, const std::vector<std::string>& extra = {}) {
+    std::vector<std::string> args = { "--no-header", "--seed", std::to_string(c.seed), c.flag,
+                                      std::to_string(c.count) };
+    args.insert(args.end(), extra.begin(), extra.end());
+    std::string text = Test::lipsum(args);
+    if (!text.empty() && text.back() == '\n')
+        text.pop_back();
+    return text;
+}
+
+TEST(generator_matches_cli, "generator/cli") {
+    Lipsum::Generator generator;
+    for (const Case& c : CASES) {
+        std::string text;
+        generator.generate(c.unit, c.count, c.seed, text);
+        if (text != cli_text(c))
+            Test::fail(__FILE__, __LINE__, std::string(c.flag) + " " + std::to_string(c.count) + " --seed " +
+                                               std::to_string(c.seed) + " differs from the CLI");
+        if (c.unit == Lipsum::Unit::BYTES)
+            CHECK_EQ(text.size(), c.count);
+    }
+}
+
+TEST(generator_matches_cli_settings, "generator/settings") {
+    Lipsum::Settings settings;
+    settings.complexity = Lipsum::Complexity::COMPLEX;
+    settings.engine = Lipsum::Engine::XOSHIRO256;
+    settings.weighted = true;
+    Lipsum::Generator generator(settings);
+    for (const Case& c : CASES) {
+        std::string text;
+        generator.generate(c.unit, c.count, c.seed, text);
+        CHECK(text == cli_text(c, { "--complex", "--rng", "xoshiro256", "--weighted" }));
+    }
+}
+
+TEST(generator_appends, "generator/append") {
+    Lipsum::Generator generator;
+    for (const Case& c : CASES) {
+        std::string text = "kept ";
+        generator.generate(c.unit, c.count, c.seed, text);
+        CHECK(text == "kept " + cli_text(c));
+    }
+    std::string text = "kept";
+    generator.generate(Lipsum::Unit::WORDS, 0, 1, text);
+    CHECK_EQ(text, "kept");
+}
+
+} /* namespace */
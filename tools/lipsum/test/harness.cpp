@@ -0,0 +1,92 @@
+#include "harness.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace Test {
+
+namespace {
+
+struct Registration {
+    std::string name;
+    Function    function;
+};
+
+std::vector<Registration>& registry() {
+    static std::vector<Registration> tests;
+    return tests;
+}
+
+/* Failures of the running test; printed once it returns */
+std::vector<std::string> g_failures;
+
+const char* USAGE =
+    "Usage:\n"
+    "  lipsum_test [options]\n\n"
+    "Options:\n"
+    "  --filter <text>     Only run tests whose name contains this text.\n"
+    "  --list              List test names and exit.\n";
+
+} /* namespace */
+
+bool register_test(const std::string& name, Function function) {
+    registry().push_back({name, function});
+    return true;
+}
+
+void fail(const char* file, int line, const std::string& message) {
+    g_failures.push_back(std::string(file) + ":" + std::to_string(line) + ": " + message);
+}
+
+int run(int argc, char* argv[]) {
+    std::string filter;
+    bool list = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--list") {
+            list = true;
+        } else {
+            std::cerr << USAGE;
+            return arg == "-h" ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    size_t ran = 0, failed = 0;
+    for (const auto& test : registry()) {
+        if (!filter.empty() && test.name.find(filter) == std::string::npos)
+            continue;
+        if (list) {
+            std::printf("%s\n", test.name.c_str());
+            continue;
+        }
+
+        g_failures.clear();
+        test.function();
+        ran++;
+        if (g_failures.empty())
+            continue;
+        failed++;
+        std::printf("FAIL %s\n", test.name.c_str());
+        /* A broken kernel can fail thousands of cases; the first few say enough */
+        const size_t shown = 10;
+        for (size_t i = 0; i < g_failures.size() && i < shown; i++)
+            std::printf("  %s\n", g_failures[i].c_str());
+        if (g_failures.size() > shown)
+            std::printf("  ... and %zu more\n", g_failures.size() - shown);
+    }
+    if (list)
+        return EXIT_SUCCESS;
+
+    std::printf("%zu tests, %zu failed\n", ran, failed);
+    return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} /* namespace Test */
+
+int main(int argc, char* argv[]) {
+    return Test::run(argc, argv);
+}
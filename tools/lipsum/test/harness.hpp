@@ -0,0 +1,57 @@
+#ifndef TEST_HARNESS_HPP
+#define TEST_HARNESS_HPP
+
+#include <sstream>
+#include <string>
+
+/**
+ * @file harness.hpp
+ * @brief A small test runner for lipsum's behavior tests, in the style of the bench harness.
+ *
+ * Tests are plain functions registered with TEST(name). CHECK() and CHECK_EQ() record a
+ * failure with its file and line and let the test go on, so one run reports every
+ * mismatch; the runner prints each failing test and exits non-zero if there was any.
+ */
+
+namespace Test {
+
+using Function = void (*)();
+
+/* Registers a test; returns true so it can initialize a static */
+bool register_test(const std::string& name, Function function);
+
+/* Records a failure of the running test */
+void fail(const char* file, int line, const std::string& message);
+
+int run(int argc, char* argv[]);
+
+template <typename A, typename B>
+void check_equal(const A& actual, const B& expected, const char* expression, const char* file, int line) {
+    if (actual == expected)
+        return;
+    std::ostringstream message;
+    message << expression << ": got " << actual << ", expected " << expected;
+    fail(file, line, message.str());
+}
+
+} /* namespace Test */
+
+#define TEST_CONCAT_(a, b) a##b
+#define TEST_CONCAT(a, b) TEST_CONCAT_(a, b)
+
+/* Defines and registers a test function; @p name is the string shown and filtered on */
+#define TEST(function, name)                                                                   \
+    void function();                                                                           \
+    static const bool TEST_CONCAT(function, _registered) = Test::register_test(name, function); \
+    void function()
+
+#define CHECK(condition)                                               \
+    do {                                                               \
+        if (!(condition))                                              \
+            Test::fail(__FILE__, __LINE__, "CHECK(" #condition ")");   \
+    } while (0)
+
+#define CHECK_EQ(actual, expected) \
+    Test::check_equal((actual), (expected), #actual " == " #expected, __FILE__, __LINE__)
+
+#endif
@@ -0,0 +1,72 @@
+#include "harness.hpp"
+#include "cli.hpp"
+#include <string>
+#include <vector>
+
+/*
+ * --range K..M: each slice is exactly paragraphs K to M-1 of the --threads text, for
+ * slices inside one 64-paragraph block, across block boundaries and far into the stream.
+ */
+
+namespace {
+
+std::vector<std::string> split_paragraphs(const std::string& text) {
+    std::vector<std::string> paragraphs;
+    size_t begin = 0;
+    while (begin < text.size()) {
+        size_t end = text.find("\n\n", begin);
+        if (end == std::string::npos)
+            end = text.size();
+        paragraphs.push_back(text.substr(begin, end - begin));
+        begin = end + 2;
+    }
+    return paragraphs;
+}
+
+std::string join_paragraphs(const std::vector<std::string>& paragraphs, size_t begin, size_t end) {
+    std::string text;
+    for (size_t i = begin; i < end; i++) {
+        if (i > begin)
+            text += "\n\n";
+        text += paragraphs[i];
+    }
+    return text + "\n";
+}
+
+std::string range(unsigned int seed, size_t begin, size_t end, unsigned int threads = 1) {
+    return Test::lipsum({ "--seed", std::to_string(seed), "--threads", std::to_string(threads), "--range",
+                          std::to_string(begin) + ".." + std::to_string(end) });
+}
+
+TEST(range_slices_full_text, "range/slices") {
+    const size_t SLICES[][2] = { { 0, 1 }, { 0, 64 }, { 3, 9 }, { 63, 65 }, { 64, 128 }, { 100, 101 },
+                                 { 5, 200 }, { 127, 129 }, { 250, 256 } };
+    for (unsigned int seed : { 1u, 2u, 42u }) {
+        std::string full = Test::lipsum({ "--seed", std::to_string(seed), "--threads", "1", "--no-header",
+                                          "-p", "256" });
+        CHECK(full.size() > 1 && full.back() == '\n');
+        full.pop_back();
+        std::vector<std::string> paragraphs = split_paragraphs(full);
+        CHECK_EQ(paragraphs.size(), size_t(256));
+        if (paragraphs.size() != 256)
+            continue;
+        for (const auto& slice : SLICES) {
+            std::string expected = join_paragraphs(paragraphs, slice[0], slice[1]);
+            CHECK_EQ(range(seed, slice[0], slice[1]), expected);
+            CHECK_EQ(range(seed, slice[0], slice[1], 3), expected);
+        }
+    }
+}
+
+TEST(range_slices_join, "range/join") {
+    /* Far into the stream, where no full run is practical: consecutive slices still join up */
+    const size_t begin = 1000000000;
+    std::string whole = range(7, begin, begin + 70);
+    std::string first = range(7, begin, begin + 30);
+    std::string second = range(7, begin + 30, begin + 70);
+    first.pop_back();
+    CHECK_EQ(first + "\n\n" + second, whole);
+    CHECK_EQ(split_paragraphs(whole).size(), size_t(70));
+}
+
+} /* namespace */
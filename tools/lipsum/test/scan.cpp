@@ -0,0 +1,175 @@
+#include "harness.hpp"
+#include "random.hpp"
+#include "scan.hpp"
+#include "text.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+ * The vector scanning kernels against the scalar reference and the iostream-based
+ * counting they replaced, at the lengths around each vector width and at every
+ * alignment of the start.
+ */
+
+namespace {
+
+/* Lengths around the 16-, 32- and 64-byte strides, where tail handling changes */
+const size_t BOUNDARY_LENGTHS[] = { 0, 1, 2, 15, 16, 17, 31, 32, 33, 47, 48, 49, 63, 64, 65,
+                                    95, 96, 97, 127, 128, 129, 191, 192, 193, 255, 256, 257 };
+
+/* Words, every whitespace byte, sentence and other punctuation, and UTF-8 */
+const char ALPHABET[] = { 'a', 'b', 'z', 'A', '.', '.', ',', '!', ' ', ' ', ' ', '\t', '\n', '\n',
+                          '\r', '\v', '\f', '&', '"', '\\', '\x01', '\x1f', '\xc3', '\xa9', '\x7f' };
+
+std::string random_text(SplitMix64& rng, size_t length) {
+    std::string text(length, ' ');
+    for (char& c : text)
+        c = ALPHABET[rng.next() % sizeof(ALPHABET)];
+    return text;
+}
+
+/* The texts every test scans: each boundary length, plus longer ones */
+std::vector<std::string> sample_texts() {
+    SplitMix64 rng(7);
+    std::vector<std::string> texts;
+    for (size_t length : BOUNDARY_LENGTHS) {
+        for (int i = 0; i < 8; i++)
+            texts.push_back(random_text(rng, length));
+        texts.push_back(std::string(length, ' '));
+        texts.push_back(std::string(length, 'a'));
+        texts.push_back(std::string(length, '\n'));
+    }
+    for (int i = 0; i < 40; i++)
+        texts.push_back(random_text(rng, 1 + rng.next() % 2000));
+    return texts;
+}
+
+/* Counting the way the helpers did before Scan: stream extraction and getline() */
+TextStats iostream_counts(const std::string& text) {
+    TextStats stats;
+    std::istringstream words(text);
+    std::string word;
+    while (words >> word)
+        stats.words++;
+    stats.sentences = static_cast<size_t>(std::count(text.begin(), text.end(), '.'));
+    std::istringstream lines(text);
+    std::string line;
+    while (std::getline(lines, line)) {
+        if (!trim(line).empty())
+            stats.paragraphs++;
+    }
+    stats.characters = text.size();
+    return stats;
+}
+
+void check_counts(const TextStats& actual, const TextStats& expected, const std::string& what) {
+    if (actual.words != expected.words || actual.sentences != expected.sentences ||
+        actual.paragraphs != expected.paragraphs || actual.characters != expected.characters) {
+        std::ostringstream message;
+        message << what << ": got " << actual.words << "/" << actual.sentences << "/" << actual.paragraphs
+                << "/" << actual.characters << " words/sentences/paragraphs/characters, expected "
+                << expected.words << "/" << expected.sentences << "/" << expected.paragraphs << "/"
+                << expected.characters;
+        Test::fail(__FILE__, __LINE__, message.str());
+    }
+}
+
+/* For each offset of @p text, the offset of the first byte from there on that @p matches */
+template <typename Matches>
+std::vector<size_t> next_match(const std::string& text, Matches matches) {
+    std::vector<size_t> next(text.size() + 1, text.size());
+    for (size_t i = text.size(); i-- > 0;)
+        next[i] = matches(text[i]) ? i : next[i + 1];
+    return next;
+}
+
+/**
+ * Runs @p check on a copy of each sample text at each of 16 offsets into a buffer, so
+ * the kernels see every alignment of the start. The bytes around the copy are '.' and
+ * 'x', which would change any count or search that read past the end.
+ **/
+template <typename Check>
+void for_each_placement(Check check) {
+    for (const std::string& text : sample_texts()) {
+        for (size_t offset = 0; offset < 16; offset++) {
+            std::vector<char> buffer(text.size() + 48, '.');
+            std::fill(buffer.begin() + offset + text.size(), buffer.end(), 'x');
+            std::copy(text.begin(), text.end(), buffer.begin() + offset);
+            check(buffer.data() + offset, text);
+        }
+    }
+}
+
+TEST(count_text_matches_iostream, "scan/count_text") {
+    for_each_placement([](const char* data, const std::string& text) {
+        TextStats expected = iostream_counts(text);
+        check_counts(Scan::count_text_scalar(data, text.size()), expected, "scalar");
+        check_counts(Scan::count_text(data, text.size()), expected, "count_text");
+        CHECK_EQ(count_words(text), expected.words);
+        CHECK_EQ(count_sentences(text), expected.sentences);
+        CHECK_EQ(count_paragraphs(text), expected.paragraphs);
+    });
+}
+
+#ifdef SCAN_X86
+TEST(count_sse2_matches_scalar, "scan/count_sse2") {
+    for_each_placement([](const char* data, const std::string& text) {
+        check_counts(Scan::count_sse2(data, text.size()), iostream_counts(text), "sse2");
+    });
+}
+
+TEST(count_avx2_matches_scalar, "scan/count_avx2") {
+    if (!__builtin_cpu_supports("avx2")) {
+        std::printf("skip scan/count_avx2: the CPU has no AVX2\n");
+        return;
+    }
+    for_each_placement([](const char* data, const std::string& text) {
+        check_counts(Scan::count_avx2(data, text.size()), iostream_counts(text), "avx2");
+    });
+}
+#endif
+
+TEST(find_space_matches_isspace, "scan/find_space") {
+    for_each_placement([](const char* data, const std::string& text) {
+        std::vector<size_t> expected = next_match(text, [](char c) {
+            return std::isspace(static_cast<unsigned char>(c)) != 0;
+        });
+        for (size_t from = 0; from <= text.size(); from++)
+            CHECK_EQ(Scan::find_space(data, from, text.size()), expected[from]);
+    });
+}
+
+TEST(find_any_matches_contains, "scan/find_any") {
+    Scan::ByteSet set = {};
+    set.bytes[set.count++] = '&';
+    set.bytes[set.count++] = '"';
+    set.bytes[set.count++] = '\\';
+    for (bool controls : { false, true }) {
+        set.controls = controls;
+        for_each_placement([&set](const char* data, const std::string& text) {
+            std::vector<size_t> expected = next_match(text, [&set](char c) { return set.contains(c); });
+            for (size_t from = 0; from <= text.size(); from++)
+                CHECK_EQ(Scan::find_any(data, from, text.size(), set), expected[from]);
+        });
+    }
+}
+
+TEST(find_word_reports_newlines, "scan/find_word") {
+    for_each_placement([](const char* data, const std::string& text) {
+        std::vector<size_t> expected = next_match(text, [](char c) {
+            return std::isspace(static_cast<unsigned char>(c)) == 0;
+        });
+        for (size_t from = 0; from <= text.size(); from++) {
+            bool newline = false;
+            CHECK_EQ(Scan::find_word(data, from, text.size(), newline), expected[from]);
+            CHECK_EQ(newline, std::find(text.begin() + from, text.begin() + expected[from], '\n') !=
+                                  text.begin() + expected[from]);
+        }
+    });
+}
+
+} /* namespace */